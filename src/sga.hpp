@@ -11,15 +11,39 @@
 #include <functional>
 #include <algorithm>
 #include <vector>
-#include <map>
-#include <deque>
+#include <array>
 #include <string>
+#include <numeric>
+#include <cmath>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+#include <atomic>
+#include <limits>
+#include <cstring>
+#include <chrono>
+#include <ctime>
 
 //#define DISABLE_NONBLOCKING_MODE //Use this to remove the dependecy to std::thread
+//#define DISABLE_SIMD //Use this to run the operators on real-valued genes one gene at a time
 
 #ifndef DISABLE_NONBLOCKING_MODE
 	#include <thread>
 	#include <mutex>
+	#include <condition_variable>
+#endif
+
+//The random generator and the real-valued operators choose between AVX-512, AVX2 and scalar kernels at run time with GCC on x86 (other compilers always use the scalar ones)
+#if !defined(DISABLE_SIMD) && defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+	#define SGA_SIMD_DISPATCH
+	#define SGA_ALWAYS_INLINE inline __attribute__((always_inline))
+	#define SGA_SCALAR_KERNEL __attribute__((optimize("fp-contract=off")))
+#elif defined(__GNUC__)
+	#define SGA_ALWAYS_INLINE inline __attribute__((always_inline))
+	#define SGA_SCALAR_KERNEL
+#else
+	#define SGA_ALWAYS_INLINE inline
+	#define SGA_SCALAR_KERNEL
 #endif
 
 namespace SGA
@@ -37,6 +61,40 @@ using Chromosome = std::vector<T>;
 template <typename T>
 using Population = std::vector< Chromosome<T> >;
 
+//Storage of the chromosomes of an algorithm: a vector if their length varies (N is 0), or an array of N genes stored inline otherwise
+//A population of arrays is a single contiguous block of genes, without any allocation per chromosome
+template <typename T, std::size_t N>
+struct ChromosomeTraits
+{
+	typedef std::array<T, N> Type;
+	
+	//Chromosome of the given length (always N)
+	static Type create(unsigned)
+	{
+		return Type();
+	}
+	
+	//Change the length of a chromosome (arrays always have N genes)
+	static void resize(Type &, unsigned)
+	{}
+};
+
+template <typename T>
+struct ChromosomeTraits<T, 0>
+{
+	typedef Chromosome<T> Type;
+	
+	static Type create(unsigned size)
+	{
+		return Type(size);
+	}
+	
+	static void resize(Type & chromosome, unsigned size)
+	{
+		chromosome.resize(size);
+	}
+};
+
 //Typedef for Score which is a double
 typedef double Score;
 
@@ -52,7 +110,8 @@ do \
 
 /* How to end the algorithm:
  *  - MaxScore: when the best chromosome from the population has a fitness score above _bestScore, the algorithm ends;
- *  - BestScore (default): when the best score doesn't get better during _steadyGenerations generations, the algorithm ends;
+ *  - BestScore (default): when the best score doesn't get better during _steadyGenerations generations, the algorithm ends
+ *    (it gets better when it exceeds the best score so far by more than _absoluteImprovement and _relativeImprovement times its magnitude);
  *  - NeverStop: the algorithm will never stop (you will have to call stop()).
  */
 enum class EndingCriterion { MaxScore, BestScore, NeverStop };
@@ -65,454 +124,3678 @@ enum class EndingCriterion { MaxScore, BestScore, NeverStop };
  */
 enum class SelectionType { RouletteWheel, StochasticUniversal, Tournament };
 
-//Handy random number generator
-struct Random
-{
-	static std::random_device   _seed;
-	static std::mt19937         _engine;
-	
-	static double get(double min, double max)
-	{
-		std::uniform_real_distribution<double> distribution(min, max);
-		return distribution(_engine);
-	}
+/* Where the migrants go in the island model:
+ *  - Ring (default): each island sends its migrants to the next one;
+ *  - FullyConnected: each island sends its migrants to all the others;
+ *  - Random: each island sends its migrants to another island chosen randomly at each migration.
+ */
+enum class MigrationTopology { Ring, FullyConnected, Random };
 
-	static float get(float min, float max)
-	{
-		std::uniform_real_distribution<float> distribution(min, max);
-		return distribution(_engine);
-	}
+/* Which chromosome a child replaces in the steady state mode (only if the child is at least as good):
+ *  - Worst (default): the worst chromosome of the population;
+ *  - Tournament: the worst of _tournamentSize randomly picked chromosomes.
+ */
+enum class ReplacementType { Worst, Tournament };
 
-	static int get(int min, int max)
-	{
-		std::uniform_int_distribution<int> distribution(min, max);
-		return distribution(_engine);
-	}
+/* How the budgets set with setBudgets() end the algorithm (in addition to the ending criterion):
+ *  - Any (default): as soon as one of them is exhausted;
+ *  - All: once all of them are exhausted.
+ */
+enum class BudgetCombination { Any, All };
 
-	static unsigned get(unsigned min, unsigned max)
-	{
-		std::uniform_int_distribution<unsigned> distribution(min, max);
-		return distribution(_engine);
-	}
-};
+/* How two parents are recombined into two children:
+ *  - Segments (default): the children exchange random segments of genes, one segment out of two;
+ *  - OnePoint: the children exchange their genes after a random point;
+ *  - TwoPoint: the children exchange their genes between two random points;
+ *  - Uniform: the children exchange each gene with a probability of 1/2;
+ *  - Blend: each gene of the children is drawn in the interval of the genes of the parents, enlarged by alpha times its width on each side (BLX-alpha, floating point genes only);
+ *  - SimulatedBinary: the genes of the children are spread around the genes of the parents like a one-point crossover of binary strings would do (SBX, floating point genes only),
+ *    the greater the distribution index, the closer to their parents;
+ *  - PartiallyMapped: each child receives a segment of the other parent, the genes of its parent in conflict with it being moved where the segment genes were (PMX, permutations only);
+ *  - Ordered: each child keeps a segment of its parent and takes the other genes in the order of the other parent (OX, permutations only);
+ *  - Cycle: the children exchange the genes of one cycle of positions out of two (CX, permutations only).
+ * NB: only the genes both parents have are recombined, the longest child keeps the end of its parent.
+ */
+enum class CrossoverType { Segments, OnePoint, TwoPoint, Uniform, Blend, SimulatedBinary, PartiallyMapped, Ordered, Cycle };
 
-//Handy macro to init the random number generator
-#define INIT_RANDOM() \
-std::random_device   SGA::Random::_seed; \
-std::mt19937         SGA::Random::_engine(SGA::Random::_seed());
+/* How a chromosome is mutated (with a probability of _mutationProbability):
+ *  - RandomGenes (default): the genes of a random segment are replaced with random genes;
+ *  - Swap: two random genes are exchanged;
+ *  - Insertion: a random gene is moved to a random position;
+ *  - Inversion: the order of the genes of a random segment is reversed (2-opt move);
+ *  - PerGene: each gene is replaced with a random gene (or flipped for bits) with a probability of _mutationProbability,
+ *    the distance to the next mutated gene being drawn directly so that the cost only depends on the number of mutated genes;
+ *  - Gaussian: a normal deviate of standard deviation _mutationDeviation is added to every gene (floating point genes only).
+ * NB: Swap, Insertion and Inversion only move genes, so they keep the permutations valid.
+ */
+enum class MutationType { RandomGenes, Swap, Insertion, Inversion, PerGene, Gaussian };
 
-/****************************/
-/** Algorithm declarations **/
-/****************************/
+//Instruction sets the random generator and the real-valued kernels can use
+enum class InstructionSet { Scalar, AVX2, AVX512 };
 
-template <typename T>
-class GeneticAlgorithm
+//Widest instruction set supported by both the compiler and the processor (detected once)
+inline InstructionSet instructionSet()
+{
+	#ifdef SGA_SIMD_DISPATCH
+	static const InstructionSet detected = []() -> InstructionSet
+	{
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+			return InstructionSet::AVX512;
+		if (__builtin_cpu_supports("avx2"))
+			return InstructionSet::AVX2;
+		return InstructionSet::Scalar;
+	}();
+	return detected;
+	#else
+	return InstructionSet::Scalar;
+	#endif
+}
+
+//Mix the bits of a 64-bit value (finalizer of splitmix64)
+inline std::uint64_t mixBits(std::uint64_t x)
+{
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+//Uniform draws shared by the random generators of the library (Generator must provide next32() and a 64-bit operator())
+template <typename Generator>
+class UniformDraws
 {
-	//Everything the user needs should be here, in the public section
 	public :
+	
+		//Integer in [0, bound) without bias (Lemire's method: a multiplication, and a division only when a rejection may be needed)
+		std::uint32_t below(std::uint32_t bound)
+		{
+			std::uint64_t product = (std::uint64_t)generator().next32() * bound;
+			std::uint32_t low = (std::uint32_t)product;
+			
+			if (low < bound)
+			{
+				const std::uint32_t threshold = (std::uint32_t)(-bound) % bound;
+				while (low < threshold)
+				{
+					product = (std::uint64_t)generator().next32() * bound;
+					low = (std::uint32_t)product;
+				}
+			}
+			
+			return (std::uint32_t)(product >> 32);
+		}
 		
-		/*-----------------------*/
-		/* Constructor and stuff */
-		/*-----------------------*/
-		
-		//Init default values, etc
-		GeneticAlgorithm();
-		
-		/*-----------------------------*/
-		/* Main functions for the user */
-		/*-----------------------------*/
-		
-		//Run the algorithm until it ends or until the user stops it
-		void run(bool blocking, bool enableLogging = false, std::ostream & outputStream = std::cout);
+		//Double in [0, 1) (53 random bits)
+		double unit()
+		{
+			return (generator()() >> 11) * (1.0 / 9007199254740992.0);
+		}
 		
-		//Stop the algorithm
-		void stop();
+		//Integer in [min, max] (returns min if the interval is empty)
+		unsigned uniform(unsigned min, unsigned max)
+		{
+			if (max <= min)
+				return min;
+			if (max - min == ~0u)
+				return generator().next32();
+			return min + below(max - min + 1);
+		}
 		
-		//Get the best chromosome
-		Chromosome<T> best();
+		//Double in [min, max) (the rounding can give max, which is then replaced with the number below)
+		double uniform(double min, double max)
+		{
+			const double number = min + (max - min) * unit();
+			return number < max || max <= min ? number : std::nextafter(max, min);
+		}
 		
-		//Set the ending criterion (with optional parameter if the user chooses MaxScore)
-		void setEndingCriterion(EndingCriterion type, Score maxScoreForMaxScoreCriterion = 0.0, unsigned numberOfGenerationsWithoutImprovementForBestScoreCriterion = 10);
+		//The bulk draws below give the same numbers as count calls to the draws above (so they don't change the results),
+		//but the generator produces the random bits of a whole chunk at once (Generator must also provide fill() for 32 and 64 bits)
 		
-		//Set the selection type (with optional parameter if the user chooses Tournament)
-		void setSelectionType(SelectionType type, unsigned numberOfChromosomesForTournament = 0);
+		//Integers in [0, bound), with the division of the rejection threshold done once
+		void below(std::uint32_t bound, std::uint32_t * numbers, unsigned count)
+		{
+			const std::uint32_t threshold = bound == 0 ? 0 : (std::uint32_t)(-bound) % bound;
+			
+			//A rejected number is replaced with the next random bits, like in below()
+			std::uint32_t bits[64];
+			unsigned available = 0;
+			unsigned used = 0;
+			for (unsigned i=0 ; i<count ; )
+			{
+				if (used == available)
+				{
+					available = std::min(count - i, 64u);
+					generator().fill(bits, available);
+					used = 0;
+				}
+				
+				const std::uint64_t product = (std::uint64_t)bits[used++] * bound;
+				if ((std::uint32_t)product >= threshold)
+					numbers[i++] = (std::uint32_t)(product >> 32);
+			}
+		}
 		
-		//Set the population size and mutation probability
-		void setMainParameters(unsigned populationSize, double mutationProbability);
+		//Numbers in [0, 1) (53 random bits converted to Real)
+		template <typename Real>
+		void unit(Real * numbers, unsigned count)
+		{
+			std::uint64_t bits[64];
+			for (unsigned i=0 ; i<count ; i+=64)
+			{
+				const unsigned chunk = std::min(count - i, 64u);
+				generator().fill(bits, chunk);
+				for (unsigned k=0 ; k<chunk ; k++)
+					numbers[i+k] = static_cast<Real>((bits[k] >> 11) * (1.0 / 9007199254740992.0));
+			}
+		}
 		
-		//Set the chromosomes size
-		void setChromosomesSize(unsigned min, unsigned max); //Just enter the same number on min and max for a constant length
+		//Standard normal deviates (Box-Muller transform: each pair of numbers takes two draws of unit(), the last one too when count is odd)
+		template <typename Real>
+		void normal(Real * numbers, unsigned count)
+		{
+			double units[64];
+			for (unsigned i=0 ; i<count ; i+=64)
+			{
+				const unsigned chunk = std::min(count - i, 64u);
+				unit(units, (chunk + 1) / 2 * 2);
+				for (unsigned k=0 ; k<chunk ; k+=2)
+				{
+					//1-unit() is in (0, 1] so the logarithm is finite
+					const double radius = std::sqrt(-2.0 * std::log(1.0 - units[k]));
+					const double angle = 6.283185307179586 * units[k+1];
+					numbers[i+k] = static_cast<Real>(radius * std::cos(angle));
+					if (k+1 < chunk)
+						numbers[i+k+1] = static_cast<Real>(radius * std::sin(angle));
+				}
+			}
+		}
+	
+	private :
+	
+		Generator & generator()
+		{
+			return * static_cast<Generator *>(this);
+		}
+};
+
+//Small and fast pseudo-random generator (xoshiro256++), also usable with the standard distributions
+class Xoshiro256 : public UniformDraws<Xoshiro256>
+{
+	public :
+	
+		typedef std::uint64_t result_type;
 		
-		/*---------------------------*/
-		/* Useful stuff for the user */
-		/*---------------------------*/
+		Xoshiro256(std::uint64_t seed = 0)
+		{
+			this->seed(seed);
+		}
 		
-		unsigned getNumberOfGenerations() const;
+		//Fill the state from a single number (with splitmix64, so that close seeds give unrelated sequences)
+		void seed(std::uint64_t seed)
+		{
+			for (unsigned i=0 ; i<4 ; i++)
+			{
+				seed += 0x9e3779b97f4a7c15ULL;
+				_state[i] = mixBits(seed);
+			}
+		}
 		
-		/*----------------------------------------------------*/
-		/* Functions which have to be implemented by the user */
-		/*----------------------------------------------------*/
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return ~(result_type)0; }
 		
-		//Generate a random value of type T
-		virtual T randomGene() const = 0;
+		//Next 64 random bits
+		result_type operator()()
+		{
+			const std::uint64_t result = rotate(_state[0] + _state[3], 23) + _state[0];
+			const std::uint64_t t = _state[1] << 17;
+			
+			_state[2] ^= _state[0];
+			_state[3] ^= _state[1];
+			_state[1] ^= _state[2];
+			_state[0] ^= _state[3];
+			_state[2] ^= t;
+			_state[3] = rotate(_state[3], 45);
+			
+			return result;
+		}
 		
-		//Compute the score of a chromosome
-		virtual Score score(Chromosome<T> const & chromosome) const = 0;
+		//Next 32 random bits (the upper ones, which are the best)
+		std::uint32_t next32()
+		{
+			return (std::uint32_t)((*this)() >> 32);
+		}
 		
-		/*----------------------------------------*/
-		/* Functions the user may want to rewrite */
-		/*----------------------------------------*/
+		//Next count numbers of 32 or 64 random bits
+		void fill(std::uint32_t * numbers, unsigned count)
+		{
+			for (unsigned i=0 ; i<count ; i++)
+				numbers[i] = next32();
+		}
 		
-		//Chromosome to string (returns empty string by default)
-		virtual std::string print(Chromosome<T> const & chromosome) const {return std::string();}
+		void fill(std::uint64_t * numbers, unsigned count)
+		{
+			for (unsigned i=0 ; i<count ; i++)
+				numbers[i] = (*this)();
+		}
 	
+	private :
 	
-	//The protected section contains the magic
-	protected :
+		static std::uint64_t rotate(std::uint64_t x, int k)
+		{
+			return (x << k) | (x >> (64 - k));
+		}
+		
+		std::uint64_t _state[4];
+};
+
+//Encrypt W consecutive counters (from counter[0]) with the key (10 rounds of Philox4x32) and write the W blocks one after the other
+//The lanes are independent, so the compiler turns the loops over them into vector instructions as wide as the target allows
+template <unsigned W>
+SGA_ALWAYS_INLINE void philoxBlocks(std::uint32_t const * key, std::uint32_t const * counter, std::uint32_t * blocks)
+{
+	std::uint32_t x[4][W];
+	for (unsigned l=0 ; l<W ; l++)
+	{
+		x[0][l] = counter[0] + l;
+		x[1][l] = counter[1];
+		x[2][l] = counter[2];
+		x[3][l] = counter[3];
+	}
+	std::uint32_t k[2] = { key[0], key[1] };
 	
-		/*------------*/
-		/* Attributes */
-		/*------------*/
+	for (unsigned round=0 ; round<10 ; round++)
+	{
+		for (unsigned l=0 ; l<W ; l++)
+		{
+			const std::uint64_t p0 = (std::uint64_t)0xD2511F53 * x[0][l];
+			const std::uint64_t p1 = (std::uint64_t)0xCD9E8D57 * x[2][l];
+			
+			const std::uint32_t y0 = (std::uint32_t)(p1 >> 32) ^ x[1][l] ^ k[0];
+			const std::uint32_t y2 = (std::uint32_t)(p0 >> 32) ^ x[3][l] ^ k[1];
+			x[0][l] = y0;
+			x[1][l] = (std::uint32_t)p1;
+			x[2][l] = y2;
+			x[3][l] = (std::uint32_t)p0;
+		}
 		
-		/* Parameters */
+		k[0] += 0x9E3779B9;
+		k[1] += 0xBB67AE85;
+	}
+	
+	for (unsigned l=0 ; l<W ; l++)
+		for (unsigned j=0 ; j<4 ; j++)
+			blocks[4*l + j] = x[j][l];
+}
 
-		unsigned 		_populationSize;		//Size of the population (default is 100)
-		EndingCriterion _endCriterion;			//Criterion to end algorithm (default is BestScore)
-		SelectionType 	_selectionType;			//Selection type (default is Tournament)
-		double 			_mutationProbability;	//Mutation probabiliy (default is 0.01)
-		Score 			_maxEndScore;			//Maximum score to reach (only used with MaxScore)
-		unsigned		_steadyGenerations;		//The number of generations without improvement before the algorithm stops (only used with BestScore)
-		unsigned 		_tournamentSize;		//Size for tournament selection (default is 10)
-		unsigned		_minChromosomeSize;		//Minimum size for a chromosome (default is 1)
-		unsigned		_maxChromosomeSize;		//Maximum size for a chromosome (default is 100)
+//Write count blocks of Philox4x32 into blocks, W at a time, and move the counter past them
+template <unsigned W>
+SGA_ALWAYS_INLINE void philoxRun(std::uint32_t const * key, std::uint32_t * counter, std::uint32_t * blocks, unsigned count)
+{
+	unsigned b = 0;
+	for ( ; b+W<=count ; b+=W, counter[0]+=W)
+		philoxBlocks<W>(key, counter, blocks + 4*b);
+	for ( ; b<count ; b++, counter[0]++)
+		philoxBlocks<1>(key, counter, blocks + 4*b);
+}
 
-		/* Things the algorithm needs for reasons */
+inline void philoxScalar(std::uint32_t const * key, std::uint32_t * counter, std::uint32_t * blocks, unsigned count)
+{
+	philoxRun<1>(key, counter, blocks, count);
+}
 
-		std::multimap<Score, Chromosome<T> > 	_population;	//The actual population (not a vector as the others because maps are automatically sorted)
-		std::deque<Score> 						_lastScores;	//Buffer used for BestScore ending criterion
-		bool 									_run;			//Boolean used to stop the algorithm if needed
-		unsigned								_generation;	//To keep track of the number of generations
-		std::mutex								_mutex;			//For thread safety
-		
-		/* Logging variables */
-		
-		bool 									_logEnable;		//Enable or disable logging to _logStream.
-		std::reference_wrapper<std::ostream> 	_logStream;		//The output stream to write messages to.
-		
-		/*----------------*/
-		/* Core functions */
-		/*----------------*/
-		
-		//Make the population evolve until an ending criterion is reached or the user stops the algorithm
-		void evolve(Population<T> population);
+#ifdef SGA_SIMD_DISPATCH
+
+__attribute__((target("avx2"))) inline void philoxAVX2(std::uint32_t const * key, std::uint32_t * counter, std::uint32_t * blocks, unsigned count)
+{
+	philoxRun<8>(key, counter, blocks, count);
+}
+
+__attribute__((target("avx512f"))) inline void philoxAVX512(std::uint32_t const * key, std::uint32_t * counter, std::uint32_t * blocks, unsigned count)
+{
+	philoxRun<16>(key, counter, blocks, count);
+}
+
+#endif
+
+//Write count blocks with the widest lanes available
+inline void philox(std::uint32_t const * key, std::uint32_t * counter, std::uint32_t * blocks, unsigned count)
+{
+	#ifdef SGA_SIMD_DISPATCH
+	if (instructionSet() == InstructionSet::AVX512)
+		return philoxAVX512(key, counter, blocks, count);
+	if (instructionSet() == InstructionSet::AVX2)
+		return philoxAVX2(key, counter, blocks, count);
+	#endif
+	philoxScalar(key, counter, blocks, count);
+}
+
+//Counter-based random generator (Philox4x32-10): the numbers only depend on the key (the seed) and on a 128-bit counter
+//The counter is made of 3 user-defined words identifying a stream, plus the position inside that stream
+//Hence any stream can be (re)started from anywhere, in any order, and always gives the same numbers
+class RandomStream : public UniformDraws<RandomStream>
+{
+	public :
+	
+		typedef std::uint64_t result_type;
 		
-		//Check if an ending criterion is reached
-		bool isEvolutionOver(); //Non-const for a minor reason
+		RandomStream(std::uint64_t seed = 0)
+		{
+			this->seed(seed);
+			restart(0, 0, 0);
+		}
 		
-		//Select a population of chromosomes to be crossed (selection)
-		Population<T> select() const;
+		//Change the key
+		void seed(std::uint64_t seed)
+		{
+			_key[0] = (std::uint32_t)seed;
+			_key[1] = (std::uint32_t)(seed >> 32);
+			_available = 0;
+		}
 		
-		//Cross chromosomes between them (recombination): is implemented for a population of 2 chromosomes
-		Population<T> cross(Population<T> const & chromosomes) const;
+		//Go to the beginning of the stream identified by the three words
+		void restart(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+		{
+			_counter[0] = 0;
+			_counter[1] = a;
+			_counter[2] = b;
+			_counter[3] = c;
+			_available = 0;
+		}
 		
-		//Make a chromosome change with a user-defined probability (mutation)
-		void mutate(Chromosome<T> & chromosome) const;
-				
-		/*--------------------------------*/
-		/* Useful stuff for the algorithm */
-		/*--------------------------------*/
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return ~(result_type)0; }
 		
-		//Generate a random chromosome
-		Chromosome<T> randomChromosome() const;
+		//Next 32 random bits
+		std::uint32_t next32()
+		{
+			//Each block gives 4 numbers
+			if (_available == 0)
+			{
+				philoxScalar(_key, _counter, _block, 1);
+				_available = 4;
+			}
+			
+			return _block[4 - _available--];
+		}
 		
-		//Get the score of the chromosome at position index in the _population
-		Score score(unsigned index) const;
+		//Next 64 random bits
+		result_type operator()()
+		{
+			const std::uint64_t high = next32();
+			return (high << 32) | next32();
+		}
 		
-		//Get the accumulation of all scores of the _population
-		Score totalScore() const;
+		//Next count numbers of 32 random bits (the whole blocks are computed several at once, directly into numbers)
+		void fill(std::uint32_t * numbers, unsigned count)
+		{
+			for ( ; count > 0 && _available > 0 ; count--)
+				*numbers++ = _block[4 - _available--];
+			
+			const unsigned blocks = count / 4;
+			philox(_key, _counter, numbers, blocks);
+			
+			for (unsigned i=4*blocks ; i<count ; i++)
+				numbers[i] = next32();
+		}
 		
-		//Get the chromosome whose accumulated fitness score is inferior to the required fitness
-		Chromosome<T> chromosome(Score fitness) const;
+		//Next count numbers of 64 random bits
+		void fill(std::uint64_t * numbers, unsigned count)
+		{
+			std::uint32_t halves[128];
+			for (unsigned i=0 ; i<count ; i+=64)
+			{
+				const unsigned chunk = std::min(count - i, 64u);
+				fill(halves, 2 * chunk);
+				for (unsigned k=0 ; k<chunk ; k++)
+					numbers[i+k] = ((std::uint64_t)halves[2*k] << 32) | halves[2*k+1];
+			}
+		}
+	
+	private :
 		
-		//Get the chromosome at position index in the _population
-		Chromosome<T> chromosome(unsigned index) const;
+		std::uint32_t	_key[2];		//The seed
+		std::uint32_t	_counter[4];	//Position in the stream followed by the stream identifier
+		std::uint32_t	_block[4];		//Last generated numbers
+		unsigned		_available;		//How many numbers of the _block haven't been used yet
+};
+
+//What the random numbers are used for, to identify the streams of the genetic operators
+enum class GeneticOperator : std::uint32_t { Initialization, Selection, Recombination, Mutation, Replacement };
+
+//Handy random number generator (each thread has its own generator, seeded differently)
+struct Random
+{
+	static std::random_device   _seed;
+	
+	//The generator of the calling thread
+	static Xoshiro256 & engine()
+	{
+		static const std::uint64_t base = ((std::uint64_t)_seed() << 32) ^ _seed();
+		static std::atomic<std::uint64_t> threads(0);
 		
-		//Get the last element of the population
-		std::pair<Score, Chromosome<T> > lastElement() const;
+		thread_local Xoshiro256 engine(base + mixBits(++threads));
+		return engine;
+	}
 	
-};
+	//Restart the generator of the calling thread from a known seed (to reproduce a sequence)
+	static void seed(std::uint64_t seed)
+	{
+		engine().seed(seed);
+	}
+	
+	static double get(double min, double max)
+	{
+		return engine().uniform(min, max);
+	}
 
-/******************************/
-/** Algorithm implementation **/
-/******************************/
+	//Float in [min, max) (the rounding to float can give max, which is then replaced with the number below)
+	static float get(float min, float max)
+	{
+		const float number = min + (max - min) * (float)engine().unit();
+		return number < max || max <= min ? number : std::nextafter(max, min);
+	}
+
+	static int get(int min, int max)
+	{
+		if (max <= min)
+			return min;
+		return (int)((long long)min + engine().uniform(0u, (unsigned)((long long)max - min)));
+	}
+
+	static unsigned get(unsigned min, unsigned max)
+	{
+		return engine().uniform(min, max);
+	}
+};
+
+//Restart the generator of the calling thread from a seed while the object lives, then give it back the state it had before
+//(so that the draws of the user between two uses of the library are not changed by them)
+class RandomSeed
+{
+	public :
+	
+		RandomSeed(std::uint64_t seed)
+		 : _saved(Random::engine())
+		{
+			Random::seed(seed);
+		}
+		
+		~RandomSeed()
+		{
+			Random::engine() = _saved;
+		}
+		
+		RandomSeed(RandomSeed const &) = delete;
+		RandomSeed & operator=(RandomSeed const &) = delete;
+	
+	private :
+	
+		Xoshiro256	_saved;	//State of the generator before the seed
+};
+
+//Handy macro to init the random number generator
+#define INIT_RANDOM() \
+std::random_device   SGA::Random::_seed;
+
+#ifndef DISABLE_NONBLOCKING_MODE
+
+//Persistent pool of worker threads used to run a task over a range of indices
+class ThreadPool
+{
+	public :
+	
+		//Start numberOfThreads-1 workers (the thread calling run() is the last one)
+		ThreadPool(unsigned numberOfThreads)
+		 : _ranges(new Range[std::max(numberOfThreads, 1u)]), _task(nullptr), _invoke(nullptr), _count(0), _chunkSize(1), _job(0), _pending(0), _quit(false)
+		{
+			for (unsigned i=1 ; i<std::max(numberOfThreads, 1u) ; i++)
+				_workers.push_back(std::thread(&ThreadPool::work, this, i));
+		}
+		
+		//Wait for the workers to finish
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_quit = true;
+			}
+			_wakeUp.notify_all();
+			
+			for (std::thread & worker : _workers)
+				worker.join();
+		}
+		
+		//Total number of threads working on a task
+		unsigned size() const
+		{
+			return _workers.size() + 1;
+		}
+		
+		//Call task(begin, end) on chunks of chunkSize indices covering [0, count) and return once all of them are done
+		//Worker w starts with chunks w, w+size(), w+2*size()... in this order, and steals half of the remaining chunks of another worker when it has none left
+		//Hence, if the most expensive indices come first, each worker starts with the most expensive chunks it can get and the cheap ones balance the end
+		//The task is not copied (nor wrapped in a std::function) so running it never allocates memory
+		template <typename Task>
+		void run(unsigned count, Task const & task, unsigned chunkSize = 1)
+		{
+			chunkSize = std::max(chunkSize, 1u);
+			const unsigned chunks = count / chunkSize + (count % chunkSize != 0);
+			for (unsigned worker=0 ; worker<size() ; worker++)
+			{
+				_ranges[worker].owner = worker;
+				_ranges[worker].begin = 0;
+				_ranges[worker].end = worker < chunks ? (chunks - worker + size() - 1) / size() : 0;
+			}
+			
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_task = &task;
+				_invoke = &ThreadPool::invoke<Task>;
+				_count = count;
+				_chunkSize = chunkSize;
+				_pending = _workers.size();
+				_error = nullptr;
+				_job++;
+			}
+			_wakeUp.notify_all();
+			
+			//Do our share of the work, then wait for the others
+			execute(0);
+			
+			std::unique_lock<std::mutex> lock(_mutex);
+			_done.wait(lock, [this](){ return _pending == 0; });
+			_task = nullptr;
+			
+			//Forward the first exception thrown by the task
+			if (_error)
+				std::rethrow_exception(_error);
+		}
+	
+	private :
+	
+		//Main loop of a worker
+		void work(unsigned worker)
+		{
+			unsigned lastJob = 0;
+			
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_wakeUp.wait(lock, [&](){ return _quit || _job != lastJob; });
+					if (_quit)
+						return;
+					lastJob = _job;
+				}
+				
+				execute(worker);
+				
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_pending--;
+				}
+				_done.notify_one();
+			}
+		}
+		
+		//Run the task on the chunks of the given worker, then on the ones it can steal
+		void execute(unsigned worker)
+		{
+			unsigned chunk;
+			while (takeChunk(worker, chunk) || (stealChunks(worker) && takeChunk(worker, chunk)))
+			{
+				const unsigned long long begin = (unsigned long long)chunk * _chunkSize;
+				const unsigned long long end = std::min(begin + _chunkSize, (unsigned long long)_count);
+				
+				try
+				{
+					_invoke(_task, begin, end);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (!_error)
+						_error = std::current_exception();
+				}
+			}
+		}
+		
+		//Take the next chunk of the worker's range
+		bool takeChunk(unsigned worker, unsigned & chunk)
+		{
+			Range & range = _ranges[worker];
+			std::lock_guard<std::mutex> lock(range.mutex);
+			if (range.begin == range.end)
+				return false;
+			
+			chunk = range.begin++ * size() + range.owner;
+			return true;
+		}
+		
+		//Move the second half of the remaining chunks of another worker to the (empty) range of the thief
+		bool stealChunks(unsigned thief)
+		{
+			for (unsigned i=1 ; i<size() ; i++)
+			{
+				Range & victim = _ranges[(thief + i) % size()];
+				unsigned owner, begin, end;
+				{
+					std::lock_guard<std::mutex> lock(victim.mutex);
+					if (victim.begin == victim.end)
+						continue;
+					
+					owner = victim.owner;
+					end = victim.end;
+					begin = end - (end - victim.begin + 1) / 2;
+					victim.end = begin;
+				}
+				
+				Range & range = _ranges[thief];
+				std::lock_guard<std::mutex> lock(range.mutex);
+				range.owner = owner;
+				range.begin = begin;
+				range.end = end;
+				return true;
+			}
+			
+			return false;
+		}
+		
+		//Call a task of a known type
+		template <typename Task>
+		static void invoke(void const * task, unsigned begin, unsigned end)
+		{
+			(* static_cast<Task const *>(task))(begin, end);
+		}
+		
+		//Chunks left to a worker: the chunks begin*size()+owner, (begin+1)*size()+owner... up to end (excluded)
+		struct Range
+		{
+			std::mutex		mutex;		//Protects the range against the thieves
+			unsigned		owner;		//Worker the chunks were given to at first (the chunks may have been stolen since)
+			unsigned		begin;		//First chunk left, in the sequence of the owner
+			unsigned		end;		//End of the chunks left, in the sequence of the owner
+			char			padding[64];//Keeps the ranges of different workers on different cache lines
+		};
+		
+		std::vector<std::thread>							_workers;	//The threads (the caller of run() is not in there)
+		std::unique_ptr<Range[]>							_ranges;	//Chunks left to each worker
+		std::mutex											_mutex;		//Protects everything below
+		std::condition_variable								_wakeUp;	//Signals a new task (or the end of the pool) to the workers
+		std::condition_variable								_done;		//Signals the end of a worker's share
+		void const *										_task;		//The task being run
+		void (*_invoke)(void const *, unsigned, unsigned);				//Calls the _task with a range of indices
+		unsigned											_count;		//The number of indices of the task
+		unsigned											_chunkSize;	//The number of indices given to the task at once
+		unsigned											_job;		//Incremented for each task so workers know there is something new
+		unsigned											_pending;	//Number of workers still running the task
+		std::exception_ptr									_error;		//First exception thrown by the task
+		bool												_quit;		//Set when the pool is destroyed
+};
+
+#endif
+
+//Bounded queue between one producer thread and one consumer thread which never blocks nor allocates (push fails when it's full, pop fails when it's empty)
+template <typename Item>
+class LockFreeQueue
+{
+	public :
+	
+		LockFreeQueue(unsigned capacity)
+		 : _slots(capacity+1), _head(0), _tail(0)
+		{}
+		
+		//Fill the item at the back of the queue with fill(Item &), the previous content of the slot can be overwritten in place (producer only)
+		template <typename Fill>
+		bool push(Fill fill)
+		{
+			const unsigned tail = _tail.load(std::memory_order_relaxed);
+			const unsigned next = (tail + 1) % _slots.size();
+			if (next == _head.load(std::memory_order_acquire))
+				return false;
+			
+			fill(_slots[tail]);
+			_tail.store(next, std::memory_order_release);
+			return true;
+		}
+		
+		//Swap the item at the front of the queue with item (consumer only)
+		bool pop(Item & item)
+		{
+			const unsigned head = _head.load(std::memory_order_relaxed);
+			if (head == _tail.load(std::memory_order_acquire))
+				return false;
+			
+			std::swap(item, _slots[head]);
+			_head.store((head + 1) % _slots.size(), std::memory_order_release);
+			return true;
+		}
+	
+	private :
+	
+		std::vector<Item>		_slots;	//One more slot than the capacity, to tell a full queue from an empty one
+		std::atomic<unsigned>	_head;	//Next slot to pop (written by the consumer)
+		std::atomic<unsigned>	_tail;	//Next slot to push (written by the producer)
+};
+
+/******************/
+/** Gene helpers **/
+/******************/
+
+//Compare two genes, only possible if the type of the genes has an equality operator (otherwise genes are always considered different)
+template <typename T, typename = void>
+struct GeneComparison
+{
+	static bool equal(T const &, T const &)
+	{
+		return false;
+	}
+};
+
+template <typename T>
+struct GeneComparison<T, decltype((void)(std::declval<T const &>() == std::declval<T const &>()))>
+{
+	static bool equal(T const & a, T const & b)
+	{
+		return a == b;
+	}
+};
+
+//Hash of a gene, only available if std::hash supports the type of the gene
+template <typename T, typename = void>
+struct GeneHash
+{
+	static const bool available = false;
+};
+
+template <typename T>
+struct GeneHash<T, decltype((void)std::hash<T>()(std::declval<T const &>()))>
+{
+	static const bool available = true;
+	
+	static std::uint64_t get(T const & gene)
+	{
+		return std::hash<T>()(gene);
+	}
+};
+
+//Hash a whole chromosome (vector or array) gene by gene (the length is part of the hash)
+template <typename Genes>
+typename std::enable_if<GeneHash<typename Genes::value_type>::available, std::uint64_t>::type hashChromosome(Genes const & chromosome)
+{
+	std::uint64_t hash = mixBits(chromosome.size());
+	for (std::size_t i=0 ; i<chromosome.size() ; i++)
+		hash = mixBits(hash ^ GeneHash<typename Genes::value_type>::get(chromosome[i]));
+	return hash;
+}
+
+template <typename Genes>
+typename std::enable_if<!GeneHash<typename Genes::value_type>::available, std::uint64_t>::type hashChromosome(Genes const &)
+{
+	throw std::runtime_error("The genes cannot be hashed with std::hash, rewrite chromosomeHash() to use the fitness cache");
+}
+
+//Exchange two genes of a chromosome, returns true if they were different
+template <typename Genes>
+bool exchangeGenes(Genes & chromosome, unsigned i, unsigned j)
+{
+	typedef typename Genes::value_type T;
+	
+	if (GeneComparison<T>::equal(chromosome[i], chromosome[j]))
+		return false;
+	
+	T tmp = chromosome[i];
+	chromosome[i] = chromosome[j];
+	chromosome[j] = tmp;
+	return true;
+}
+
+//Exchange the genes of two chromosomes between begin and end (excluded), returns true if at least one of them was different
+template <typename Genes>
+bool swapGenes(Genes & first, Genes & second, unsigned begin, unsigned end)
+{
+	typedef typename Genes::value_type T;
+	
+	bool changed = false;
+	for (unsigned i=begin ; i<end ; i++)
+	{
+		if (GeneComparison<T>::equal(first[i], second[i]))
+			continue;
+		
+		T tmp = first[i];
+		first[i] = second[i];
+		second[i] = tmp;
+		changed = true;
+	}
+	
+	return changed;
+}
+
+//Draw a segment of genes between two random points (included)
+template <typename Generator>
+void randomSegment(unsigned size, Generator & random, unsigned & begin, unsigned & end)
+{
+	begin = random.below(size);
+	end = random.below(size);
+	if (begin > end)
+		std::swap(begin, end);
+}
+
+//The crossovers below work in place on children holding copies of their parents, on their first size genes, and return true if a gene changed
+
+//Exchange the genes after a random point
+template <typename Genes, typename Generator>
+bool onePointCrossover(Genes & first, Genes & second, unsigned size, Generator & random)
+{
+	if (size < 2)
+		return false;
+	
+	return swapGenes(first, second, random.uniform(1u, size-1), size);
+}
+
+//Exchange the genes between two random points (included)
+template <typename Genes, typename Generator>
+bool twoPointCrossover(Genes & first, Genes & second, unsigned size, Generator & random)
+{
+	if (size == 0)
+		return false;
+	
+	unsigned begin, end;
+	randomSegment(size, random, begin, end);
+	
+	return swapGenes(first, second, begin, end+1);
+}
+
+//Exchange each gene with a probability of 1/2 (one random bit per gene)
+template <typename Genes, typename Generator>
+bool uniformCrossover(Genes & first, Genes & second, unsigned size, Generator & random)
+{
+	//The random words are drawn 64 at a time
+	const unsigned numberOfWords = (size + 63) / 64;
+	std::uint64_t words[64];
+	bool changed = false;
+	for (unsigned i=0 ; i<size ; i++)
+	{
+		if (i % 4096 == 0)
+			random.fill(words, std::min(numberOfWords - i/64, 64u));
+		
+		if ((words[i/64 % 64] >> (i % 64)) & 1)
+			changed = swapGenes(first, second, i, i+1) || changed;
+	}
+	
+	return changed;
+}
+
+//Number of failures before the next success of events of probability p, given log(1-p) (geometric distribution, inverse transform)
+//Returned as a double since it can be huge when p is tiny
+template <typename Generator>
+double geometricSkip(double logOfFailure, Generator & random)
+{
+	//1-unit() is in (0, 1] so the logarithm is finite
+	return std::floor(std::log(1.0 - random.unit()) / logOfFailure);
+}
+
+//The mutations below move genes around without changing them (they keep the permutations valid), and return true if a gene changed
+
+//Exchange two random genes
+template <typename Genes, typename Generator>
+bool swapMutation(Genes & chromosome, Generator & random)
+{
+	if (chromosome.size() < 2)
+		return false;
+	
+	return exchangeGenes(chromosome, random.below(chromosome.size()), random.below(chromosome.size()));
+}
+
+//Move a random gene to a random position, the genes in-between being shifted by one position
+template <typename Genes, typename Generator>
+bool insertionMutation(Genes & chromosome, Generator & random)
+{
+	if (chromosome.size() < 2)
+		return false;
+	
+	const unsigned from = random.below(chromosome.size());
+	const unsigned to = random.below(chromosome.size());
+	
+	bool changed = false;
+	for (unsigned i=from ; i<to ; i++)
+		changed = exchangeGenes(chromosome, i, i+1) || changed;
+	for (unsigned i=from ; i>to ; i--)
+		changed = exchangeGenes(chromosome, i, i-1) || changed;
+	
+	return changed;
+}
+
+//Reverse the order of the genes between two random positions (included), which is a 2-opt move for the routes
+template <typename Genes, typename Generator>
+bool inversionMutation(Genes & chromosome, Generator & random)
+{
+	if (chromosome.size() < 2)
+		return false;
+	
+	unsigned begin, end;
+	randomSegment(chromosome.size(), random, begin, end);
+	
+	bool changed = false;
+	for ( ; begin<end ; begin++, end--)
+		changed = exchangeGenes(chromosome, begin, end) || changed;
+	
+	return changed;
+}
+
+/*********************/
+/** Bit chromosomes **/
+/*********************/
+
+//Gene of the binary chromosomes packed 64 bits per word: use GeneticAlgorithm<Bit> or GeneticAlgorithm<Bit, N>
+//The recombination and the mutation then work on whole words (randomGene() is only used to create the first population)
+struct Bit
+{
+	Bit(bool value = false)
+	 : value(value)
+	{}
+	
+	operator bool() const
+	{
+		return value;
+	}
+	
+	bool value;
+};
+
+//Number of bits set in a word
+inline unsigned popCount(std::uint64_t word)
+{
+	#if defined(__GNUC__)
+	return __builtin_popcountll(word);
+	#else
+	word = word - ((word >> 1) & 0x5555555555555555ULL);
+	word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (word * 0x0101010101010101ULL) >> 56;
+	#endif
+}
+
+//Bits of the word-th word of a chromosome which are between begin and end (excluded)
+inline std::uint64_t wordMask(unsigned word, unsigned begin, unsigned end)
+{
+	const unsigned first = word * 64;
+	const unsigned low = begin > first ? begin - first : 0;
+	const unsigned high = std::min(end - first, 64u);
+	const std::uint64_t lowMask = ~std::uint64_t(0) << low;
+	const std::uint64_t highMask = high == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << high) - 1;
+	return lowMask & highMask;
+}
+
+//Binary chromosome of N bits (or of any length if N is 0) packed in 64-bit words, the unused bits of the last word are always 0
+template <std::size_t N>
+class BitChromosome
+{
+	public :
+		
+		typedef Bit value_type;
+		
+		//Writable bit
+		class Reference
+		{
+			public :
+			
+				Reference(std::uint64_t & word, std::uint64_t mask)
+				 : _word(word), _mask(mask)
+				{}
+				
+				Reference & operator=(Bit bit)
+				{
+					_word = bit ? (_word | _mask) : (_word & ~_mask);
+					return *this;
+				}
+				
+				Reference & operator=(Reference const & other)
+				{
+					return *this = Bit(static_cast<bool>(other));
+				}
+				
+				operator Bit() const
+				{
+					return (_word & _mask) != 0;
+				}
+				
+				operator bool() const
+				{
+					return (_word & _mask) != 0;
+				}
+			
+			private :
+			
+				std::uint64_t &	_word;	//Word holding the bit
+				std::uint64_t	_mask;	//The bit in the word
+		};
+		
+		BitChromosome(unsigned size = N)
+		 : _size(N > 0 ? N : size)
+		{
+			resizeWords(_words, (_size + 63) / 64);
+		}
+		
+		unsigned size() const
+		{
+			return _size;
+		}
+		
+		bool empty() const
+		{
+			return _size == 0;
+		}
+		
+		//Change the number of bits (always N if it is not 0)
+		void resize(unsigned size)
+		{
+			if (N > 0)
+				return;
+			
+			resizeWords(_words, (size + 63) / 64);
+			if (size < _size && size % 64 != 0)
+				_words[size / 64] &= wordMask(size / 64, 0, size);
+			_size = size;
+		}
+		
+		Bit operator[](unsigned i) const
+		{
+			return (_words[i / 64] >> (i % 64)) & 1;
+		}
+		
+		Reference operator[](unsigned i)
+		{
+			return Reference(_words[i / 64], std::uint64_t(1) << (i % 64));
+		}
+		
+		//The words holding the bits (bit i is the bit i%64 of the word i/64)
+		std::uint64_t * words()
+		{
+			return _words.data();
+		}
+		
+		std::uint64_t const * words() const
+		{
+			return _words.data();
+		}
+		
+		unsigned numberOfWords() const
+		{
+			return _words.size();
+		}
+		
+		//Number of bits set
+		unsigned count() const
+		{
+			unsigned count = 0;
+			for (unsigned w=0 ; w<_words.size() ; w++)
+				count += popCount(_words[w]);
+			return count;
+		}
+		
+		void swap(BitChromosome & other)
+		{
+			std::swap(_words, other._words);
+			std::swap(_size, other._size);
+		}
+		
+		bool operator==(BitChromosome const & other) const
+		{
+			return _size == other._size && std::equal(_words.begin(), _words.end(), other._words.begin());
+		}
+		
+		bool operator!=(BitChromosome const & other) const
+		{
+			return !(*this == other);
+		}
+	
+	private :
+		
+		typedef typename std::conditional<N == 0, std::vector<std::uint64_t>, std::array<std::uint64_t, (N + 63) / 64> >::type Words;
+		
+		static void resizeWords(std::vector<std::uint64_t> & words, unsigned count)
+		{
+			words.resize(count, 0);
+		}
+		
+		template <std::size_t Count>
+		static void resizeWords(std::array<std::uint64_t, Count> & words, unsigned)
+		{
+			words.fill(0);
+		}
+		
+		Words		_words;	//The bits
+		unsigned	_size;	//Number of bits
+};
+
+//Same as the generic swapGenes() with whole words: the bits are exchanged through masks
+template <std::size_t N>
+bool swapGenes(BitChromosome<N> & first, BitChromosome<N> & second, unsigned begin, unsigned end)
+{
+	if (begin >= end)
+		return false;
+	
+	std::uint64_t * a = first.words();
+	std::uint64_t * b = second.words();
+	std::uint64_t different = 0;
+	for (unsigned w=begin/64 ; w<=(end-1)/64 ; w++)
+	{
+		const std::uint64_t mask = (a[w] ^ b[w]) & wordMask(w, begin, end);
+		a[w] ^= mask;
+		b[w] ^= mask;
+		different |= mask;
+	}
+	
+	return different != 0;
+}
+
+//Same as the generic uniformCrossover() with whole words: a random mask chooses the bits exchanged
+template <std::size_t N, typename Generator>
+bool uniformCrossover(BitChromosome<N> & first, BitChromosome<N> & second, unsigned size, Generator & random)
+{
+	if (size == 0)
+		return false;
+	
+	std::uint64_t * a = first.words();
+	std::uint64_t * b = second.words();
+	const unsigned numberOfWords = (size-1)/64 + 1;
+	std::uint64_t bits[64];
+	std::uint64_t different = 0;
+	for (unsigned w=0 ; w<numberOfWords ; w++)
+	{
+		if (w % 64 == 0)
+			random.fill(bits, std::min(numberOfWords - w, 64u));
+		
+		const std::uint64_t mask = (a[w] ^ b[w]) & bits[w % 64] & wordMask(w, 0, size);
+		a[w] ^= mask;
+		b[w] ^= mask;
+		different |= mask;
+	}
+	
+	return different != 0;
+}
+
+//Replace the bits between begin and end (excluded) with random bits, returns true if at least one of them changed
+template <std::size_t N, typename Generator>
+bool randomizeBits(BitChromosome<N> & chromosome, unsigned begin, unsigned end, Generator & generator)
+{
+	if (begin >= end)
+		return false;
+	
+	//XOR with random bits gives random bits
+	std::uint64_t * words = chromosome.words();
+	const unsigned first = begin/64;
+	const unsigned last = (end-1)/64;
+	std::uint64_t bits[64];
+	std::uint64_t flipped = 0;
+	for (unsigned w=first ; w<=last ; w++)
+	{
+		if ((w - first) % 64 == 0)
+			generator.fill(bits, std::min(last + 1 - w, 64u));
+		
+		const std::uint64_t mask = bits[(w - first) % 64] & wordMask(w, begin, end);
+		words[w] ^= mask;
+		flipped |= mask;
+	}
+	
+	return flipped != 0;
+}
+
+//Hash of the words (the length is part of the hash)
+template <std::size_t N>
+std::uint64_t hashChromosome(BitChromosome<N> const & chromosome)
+{
+	std::uint64_t hash = mixBits(chromosome.size());
+	for (unsigned w=0 ; w<chromosome.numberOfWords() ; w++)
+		hash = mixBits(hash ^ chromosome.words()[w]);
+	return hash;
+}
+
+template <std::size_t N>
+struct ChromosomeTraits<Bit, N>
+{
+	typedef BitChromosome<N> Type;
+	
+	static Type create(unsigned size)
+	{
+		return Type(size);
+	}
+	
+	static void resize(Type & chromosome, unsigned size)
+	{
+		chromosome.resize(size);
+	}
+};
+
+template <>
+struct ChromosomeTraits<Bit, 0>
+{
+	typedef BitChromosome<0> Type;
+	
+	static Type create(unsigned size)
+	{
+		return Type(size);
+	}
+	
+	static void resize(Type & chromosome, unsigned size)
+	{
+		chromosome.resize(size);
+	}
+};
+
+/******************/
+/** Permutations **/
+/******************/
+
+//The permutation operators work on chromosomes holding each integer from 0 to size-1 exactly once (orders of cities, jobs, etc)
+//They find the genes through tables of positions indexed by gene, so each operation is linear in the size of the chromosomes
+
+//Scratch tables of the permutation operators (each thread has its own tables, which keep their memory from one operation to the next)
+inline std::vector<unsigned> & permutationTable(unsigned index)
+{
+	thread_local std::vector<unsigned> tables[2];
+	return tables[index];
+}
+
+//Fill positions with the position of each gene of a permutation of 0..size-1 (throws if it is not a permutation)
+template <typename Genes>
+void indexPermutation(Genes const & permutation, unsigned size, std::vector<unsigned> & positions)
+{
+	positions.assign(size, size);
+	for (unsigned i=0 ; i<size ; i++)
+	{
+		const std::size_t gene = static_cast<std::size_t>(permutation[i]);
+		if (gene >= size || positions[gene] != size)
+			throw std::runtime_error("A permutation chromosome must hold each integer from 0 to its size-1 exactly once");
+		positions[gene] = i;
+	}
+}
+
+//Fill the first size genes of a chromosome with a random permutation of 0..size-1 (Fisher-Yates shuffle)
+template <typename Genes, typename Generator>
+void randomPermutation(Genes & chromosome, unsigned size, Generator & random)
+{
+	typedef typename Genes::value_type T;
+	
+	for (unsigned i=0 ; i<size ; i++)
+		chromosome[i] = static_cast<T>(i);
+	
+	for (unsigned i=size ; i>1 ; i--)
+		exchangeGenes(chromosome, i-1, random.below(i));
+}
+
+//Each child receives the segment of the other parent, the genes of its parent in conflict with the segment being moved where the segment genes were (PMX)
+//Implemented as a series of exchanges inside each child, which gives the same children as the mapping of the genes
+template <typename Genes, typename Generator>
+bool partiallyMappedCrossover(Genes const & first, Genes const & second, Genes & firstChild, Genes & secondChild, unsigned size, Generator & random)
+{
+	if (size < 2)
+		return false;
+	
+	unsigned begin, end;
+	randomSegment(size, random, begin, end);
+	
+	std::vector<unsigned> & positionsInFirst = permutationTable(0);
+	std::vector<unsigned> & positionsInSecond = permutationTable(1);
+	indexPermutation(firstChild, size, positionsInFirst);
+	indexPermutation(secondChild, size, positionsInSecond);
+	
+	bool changed = false;
+	for (unsigned i=begin ; i<=end ; i++)
+	{
+		//Bring the gene of the other parent at position i, where it is in this child
+		const unsigned j = positionsInFirst[static_cast<std::size_t>(second[i])];
+		if (j != i)
+		{
+			positionsInFirst[static_cast<std::size_t>(firstChild[i])] = j;
+			positionsInFirst[static_cast<std::size_t>(second[i])] = i;
+			exchangeGenes(firstChild, i, j);
+			changed = true;
+		}
+		
+		const unsigned k = positionsInSecond[static_cast<std::size_t>(first[i])];
+		if (k != i)
+		{
+			positionsInSecond[static_cast<std::size_t>(secondChild[i])] = k;
+			positionsInSecond[static_cast<std::size_t>(first[i])] = i;
+			exchangeGenes(secondChild, i, k);
+			changed = true;
+		}
+	}
+	
+	return changed;
+}
+
+//Each child keeps a segment of its parent and takes the other genes in the order they have in the other parent, starting after the segment (OX)
+template <typename Genes, typename Generator>
+bool orderCrossover(Genes const & first, Genes const & second, Genes & firstChild, Genes & secondChild, unsigned size, Generator & random)
+{
+	if (size < 2)
+		return false;
+	
+	unsigned begin, end;
+	randomSegment(size, random, begin, end);
+	
+	//The tables only tell which genes are in the kept segments
+	std::vector<unsigned> & positionsInFirst = permutationTable(0);
+	std::vector<unsigned> & positionsInSecond = permutationTable(1);
+	indexPermutation(first, size, positionsInFirst);
+	indexPermutation(second, size, positionsInSecond);
+	
+	auto fill = [&](Genes const & other, std::vector<unsigned> const & positions, Genes & child)
+	{
+		typedef typename Genes::value_type T;
+		
+		bool changed = false;
+		unsigned next = (end + 1) % size;
+		for (unsigned k=1 ; k<=size ; k++)
+		{
+			const T gene = other[(end + k) % size];
+			const unsigned position = positions[static_cast<std::size_t>(gene)];
+			if (position >= begin && position <= end)
+				continue;
+			
+			if (!GeneComparison<T>::equal(child[next], gene))
+			{
+				child[next] = gene;
+				changed = true;
+			}
+			next = (next + 1) % size;
+		}
+		
+		return changed;
+	};
+	
+	const bool firstChanged = fill(second, positionsInFirst, firstChild);
+	const bool secondChanged = fill(first, positionsInSecond, secondChild);
+	return firstChanged || secondChanged;
+}
+
+//The positions are split into cycles (the gene of the second parent at a position is found in the first parent at the next position of the cycle)
+//The children keep the genes of their parent on one cycle out of two and exchange them on the others (CX, without random numbers)
+template <typename Genes, typename Generator>
+bool cycleCrossover(Genes const & first, Genes const & second, Genes & firstChild, Genes & secondChild, unsigned size, Generator &)
+{
+	std::vector<unsigned> & positionsInFirst = permutationTable(0);
+	std::vector<unsigned> & visited = permutationTable(1);
+	indexPermutation(first, size, positionsInFirst);
+	visited.assign(size, 0);
+	
+	bool changed = false;
+	bool exchange = false;
+	for (unsigned start=0 ; start<size ; start++)
+	{
+		if (visited[start])
+			continue;
+		
+		unsigned i = start;
+		do
+		{
+			visited[i] = 1;
+			if (exchange)
+				changed = swapGenes(firstChild, secondChild, i, i+1) || changed;
+			i = positionsInFirst[static_cast<std::size_t>(second[i])];
+		}
+		while (i != start);
+		
+		exchange = !exchange;
+	}
+	
+	return changed;
+}
+
+/***********************/
+/** Real-valued genes **/
+/***********************/
+
+//The operators on float and double genes run kernels working on several genes at once (AVX-512 or AVX2 lanes, chosen at run time, or one gene at a time)
+//Each lane does exactly the operations of the scalar kernel, without fused multiply-adds, so the results don't depend on the processor
+//The random numbers are drawn beforehand into per-thread buffers, in the same order whatever the width of the lanes
+
+//Unsigned integer with the size of a float or a double
+template <typename T>
+struct LaneWord;
+
+template <>
+struct LaneWord<float>
+{
+	typedef std::uint32_t Type;
+};
+
+template <>
+struct LaneWord<double>
+{
+	typedef std::uint64_t Type;
+};
+
+//W genes of type T processed at once: a vector of the compiler (GCC extension), or the gene itself for a single lane
+//Changes records which genes a kernel modified: the differing bits of each lane, or a flag for a single lane
+template <typename T, unsigned W>
+struct RealLanes
+{
+	#ifdef SGA_SIMD_DISPATCH
+	typedef T Vector __attribute__((vector_size(W * sizeof(T))));
+	typedef typename LaneWord<T>::Type Changes __attribute__((vector_size(W * sizeof(T))));
+	#endif
+};
+
+template <typename T>
+struct RealLanes<T, 1>
+{
+	typedef T Vector;
+	typedef bool Changes;
+};
+
+//Tell if two genes have the same representation (-0 differs from 0 and a NaN equals itself, as with the bits of the lanes)
+inline bool sameBits(float a, float b)
+{
+	std::uint32_t x, y;
+	std::memcpy(&x, &a, sizeof(a));
+	std::memcpy(&y, &b, sizeof(b));
+	return x == y;
+}
+
+inline bool sameBits(double a, double b)
+{
+	std::uint64_t x, y;
+	std::memcpy(&x, &a, sizeof(a));
+	std::memcpy(&y, &b, sizeof(b));
+	return x == y;
+}
+
+template <typename T>
+bool sameBits(T a, T b)
+{
+	return (a == b && std::signbit(a) == std::signbit(b)) || (a != a && b != b);
+}
+
+//Record the genes which differ from their previous values
+//The lanes are compared bit by bit rather than with a comparison mask, which some compilers can't keep in AVX-512 registers
+template <typename T>
+SGA_ALWAYS_INLINE void markChanges(bool & changed, T const & genes, T const & previous)
+{
+	changed = changed || !sameBits(genes, previous);
+}
+
+template <typename Changes, typename Vector>
+SGA_ALWAYS_INLINE void markChanges(Changes & changed, Vector const & genes, Vector const & previous)
+{
+	Changes x, y;
+	std::memcpy(&x, &genes, sizeof(x));
+	std::memcpy(&y, &previous, sizeof(y));
+	changed |= x ^ y;
+}
+
+//Tell if a kernel modified a gene
+inline bool anyChange(bool changed)
+{
+	return changed;
+}
+
+template <typename Changes>
+bool anyChange(Changes const & changed)
+{
+	for (unsigned k=0 ; k<sizeof(Changes)/sizeof(changed[0]) ; k++)
+		if (changed[k])
+			return true;
+	return false;
+}
+
+//Copy the lanes of the A first arrays from or to the index i (unrolled at compile time so that the lanes stay in registers)
+template <unsigned A>
+struct LaneCopy
+{
+	template <typename Vector, typename T>
+	static SGA_ALWAYS_INLINE void load(Vector * lanes, T * const * pointers, unsigned i)
+	{
+		LaneCopy<A-1>::load(lanes, pointers, i);
+		std::memcpy(&lanes[A-1], pointers[A-1] + i, sizeof(Vector));
+	}
+	
+	template <typename Vector, typename T>
+	static SGA_ALWAYS_INLINE void store(Vector const * lanes, T * const * pointers, unsigned i)
+	{
+		LaneCopy<A-1>::store(lanes, pointers, i);
+		std::memcpy(pointers[A-1] + i, &lanes[A-1], sizeof(Vector));
+	}
+};
+
+template <>
+struct LaneCopy<0>
+{
+	template <typename Vector, typename T>
+	static SGA_ALWAYS_INLINE void load(Vector *, T * const *, unsigned) {}
+	
+	template <typename Vector, typename T>
+	static SGA_ALWAYS_INLINE void store(Vector const *, T * const *, unsigned) {}
+};
+
+//Run a kernel on the first size genes of its arrays, W genes of type T at a time
+//The full groups of genes are loaded from the arrays directly, the last genes go through padded copies so that they are computed the same way
+//The padding repeats the first of the last genes: the padding lanes change exactly when this gene does, so they never report a change of their own
+template <typename T, unsigned W, typename Kernel>
+SGA_ALWAYS_INLINE bool runLanes(Kernel const & parameters, T * const * arrays, unsigned size)
+{
+	typedef typename RealLanes<T, W>::Vector Vector;
+	
+	//Local copies of the kernel and of the pointers, which the writes into the arrays cannot change
+	const Kernel kernel = parameters;
+	T * pointers[Kernel::numberOfArrays];
+	std::copy(arrays, arrays + Kernel::numberOfArrays, pointers);
+	
+	Vector lanes[Kernel::numberOfArrays];
+	typename RealLanes<T, W>::Changes changed = typename RealLanes<T, W>::Changes();
+	unsigned i = 0;
+	for ( ; i+W<=size ; i+=W)
+	{
+		LaneCopy<Kernel::numberOfArrays>::load(lanes, pointers, i);
+		kernel(lanes, changed);
+		LaneCopy<Kernel::numberOfArrays>::store(lanes, pointers, i);
+	}
+	
+	if (i < size)
+	{
+		for (unsigned a=0 ; a<Kernel::numberOfArrays ; a++)
+		{
+			T * lane = reinterpret_cast<T *>(&lanes[a]);
+			for (unsigned k=size-i ; k<W ; k++)
+				std::memcpy(lane + k, pointers[a] + i, sizeof(T));
+			std::memcpy(lane, pointers[a] + i, (size - i) * sizeof(T));
+		}
+		kernel(lanes, changed);
+		for (unsigned a=0 ; a<Kernel::numberOfArrays ; a++)
+			std::memcpy(pointers[a] + i, &lanes[a], (size - i) * sizeof(T));
+	}
+	
+	return anyChange(changed);
+}
+
+//Keep the genes between min and max (a NaN gene stays NaN: its comparisons are false, so it is never replaced by a bound)
+template <typename Vector, typename T>
+SGA_ALWAYS_INLINE void clampLanes(Vector & genes, T min, T max)
+{
+	const Vector low = Vector() + min;
+	const Vector high = Vector() + max;
+	genes = genes < low ? low : genes;
+	genes = genes > high ? high : genes;
+}
+
+//Kernel of the blend crossover: the arrays are the two children (copies of the parents) and the uniform numbers of each child
+template <typename T>
+struct BlendKernel
+{
+	static const unsigned numberOfArrays = 4;
+	
+	T alpha;	//Enlargement of the intervals
+	T min;		//Bounds of the genes
+	T max;
+	
+	template <typename Vector, typename Changes>
+	SGA_ALWAYS_INLINE void operator()(Vector * lanes, Changes & changed) const
+	{
+		const Vector a = lanes[0];
+		const Vector b = lanes[1];
+		const Vector low = a < b ? a : b;
+		const Vector high = a < b ? b : a;
+		const Vector extent = (high - low) * alpha;
+		const Vector from = low - extent;
+		const Vector width = (high + extent) - from;
+		lanes[0] = from + width * lanes[2];
+		lanes[1] = from + width * lanes[3];
+		clampLanes(lanes[0], min, max);
+		clampLanes(lanes[1], min, max);
+		markChanges(changed, lanes[0], a);
+		markChanges(changed, lanes[1], b);
+	}
+};
+
+//Kernel of the Gaussian mutation: the arrays are the genes and their standard normal deviates
+template <typename T>
+struct PerturbKernel
+{
+	static const unsigned numberOfArrays = 2;
+	
+	T deviation;	//Standard deviation of the noise
+	T min;			//Bounds of the genes
+	T max;
+	
+	template <typename Vector, typename Changes>
+	SGA_ALWAYS_INLINE void operator()(Vector * lanes, Changes & changed) const
+	{
+		const Vector genes = lanes[0];
+		lanes[0] = genes + lanes[1] * deviation;
+		clampLanes(lanes[0], min, max);
+		markChanges(changed, lanes[0], genes);
+	}
+};
+
+//Kernel of the bounds: the only array is the genes
+template <typename T>
+struct ClampKernel
+{
+	static const unsigned numberOfArrays = 1;
+	
+	T min;	//Bounds of the genes
+	T max;
+	
+	template <typename Vector, typename Changes>
+	SGA_ALWAYS_INLINE void operator()(Vector * lanes, Changes & changed) const
+	{
+		const Vector genes = lanes[0];
+		clampLanes(lanes[0], min, max);
+		markChanges(changed, lanes[0], genes);
+	}
+};
+
+//The kernels compiled for each instruction set (the multiply-adds are never fused, so that every instruction set gives the same results)
+template <typename T, typename Kernel>
+SGA_SCALAR_KERNEL bool runScalarKernel(Kernel const & kernel, T * const * arrays, unsigned size)
+{
+	return runLanes<T, 1>(kernel, arrays, size);
+}
+
+#ifdef SGA_SIMD_DISPATCH
+
+template <typename T, typename Kernel>
+__attribute__((target("avx2"), optimize("fp-contract=off"))) bool runAVX2Kernel(Kernel const & kernel, T * const * arrays, unsigned size)
+{
+	return runLanes<T, 32 / sizeof(T)>(kernel, arrays, size);
+}
+
+template <typename T, typename Kernel>
+__attribute__((target("avx512f,avx512dq"), optimize("fp-contract=off"))) bool runAVX512Kernel(Kernel const & kernel, T * const * arrays, unsigned size)
+{
+	return runLanes<T, 64 / sizeof(T)>(kernel, arrays, size);
+}
+
+#endif
+
+//Run a kernel with the widest lanes available (float and double only, the other floating point types always use the scalar kernel)
+template <typename T, typename Kernel>
+bool runRealKernel(Kernel const & kernel, T * const * arrays, unsigned size, std::false_type)
+{
+	return runScalarKernel(kernel, arrays, size);
+}
+
+template <typename T, typename Kernel>
+bool runRealKernel(Kernel const & kernel, T * const * arrays, unsigned size, std::true_type)
+{
+	#ifdef SGA_SIMD_DISPATCH
+	if (instructionSet() == InstructionSet::AVX512)
+		return runAVX512Kernel(kernel, arrays, size);
+	if (instructionSet() == InstructionSet::AVX2)
+		return runAVX2Kernel(kernel, arrays, size);
+	#endif
+	
+	return runScalarKernel(kernel, arrays, size);
+}
+
+template <typename T, typename Kernel>
+bool runRealKernel(Kernel const & kernel, T * const * arrays, unsigned size)
+{
+	typedef std::integral_constant<bool, std::is_same<T, float>::value || std::is_same<T, double>::value> Vectorizable;
+	return runRealKernel(kernel, arrays, size, Vectorizable());
+}
+
+//Buffer of random numbers of the calling thread (which keeps its memory from one operation to the next)
+template <typename T>
+std::vector<T> & randomNumbers(unsigned size)
+{
+	thread_local std::vector<T> numbers;
+	numbers.resize(size);
+	return numbers;
+}
+
+//The operators below take floating point genes, keep the genes they produce between min and max, and return true if a gene changed
+
+//Keep the first size genes between min and max
+template <typename Genes>
+bool clampGenes(Genes & chromosome, unsigned size, double min, double max)
+{
+	typedef typename Genes::value_type T;
+	
+	const ClampKernel<T> kernel = { static_cast<T>(min), static_cast<T>(max) };
+	T * arrays[] = { chromosome.data() };
+	return runRealKernel(kernel, arrays, size);
+}
+
+//Draw both genes in the interval of the parents enlarged by alpha times its width on each side (BLX-alpha)
+template <typename Genes, typename Generator>
+bool blendCrossover(Genes & first, Genes & second, unsigned size, double alpha, Generator & random, double min = -std::numeric_limits<double>::infinity(), double max = std::numeric_limits<double>::infinity())
+{
+	typedef typename Genes::value_type T;
+	
+	std::vector<T> & uniforms = randomNumbers<T>(2 * size);
+	random.unit(uniforms.data(), 2 * size);
+	
+	const BlendKernel<T> kernel = { static_cast<T>(alpha), static_cast<T>(min), static_cast<T>(max) };
+	T * arrays[] = { first.data(), second.data(), uniforms.data(), uniforms.data() + size };
+	return runRealKernel(kernel, arrays, size);
+}
+
+//Spread both genes around the genes of the parents with a polynomial distribution of the given index (SBX)
+//The mean of the children is the mean of the parents (before they are bounded)
+template <typename Genes, typename Generator>
+bool simulatedBinaryCrossover(Genes & first, Genes & second, unsigned size, double distributionIndex, Generator & random, double min = -std::numeric_limits<double>::infinity(), double max = std::numeric_limits<double>::infinity())
+{
+	typedef typename Genes::value_type T;
+	
+	const double exponent = 1.0 / (distributionIndex + 1.0);
+	bool changed = false;
+	for (unsigned i=0 ; i<size ; i++)
+	{
+		const double a = first[i];
+		const double b = second[i];
+		if (a == b)
+			continue;
+		
+		const double u = random.unit();
+		const double beta = u <= 0.5 ? std::pow(2.0 * u, exponent) : std::pow(1.0 / (2.0 * (1.0 - u)), exponent);
+		first[i] = static_cast<T>(0.5 * ((1.0 + beta) * a + (1.0 - beta) * b));
+		second[i] = static_cast<T>(0.5 * ((1.0 - beta) * a + (1.0 + beta) * b));
+		changed = true;
+	}
+	
+	//Without bounds there is nothing to clamp (the children can't go past the infinities)
+	if (min == -std::numeric_limits<double>::infinity() && max == std::numeric_limits<double>::infinity())
+		return changed;
+	
+	const bool firstBounded = clampGenes(first, size, min, max);
+	const bool secondBounded = clampGenes(second, size, min, max);
+	return changed || firstBounded || secondBounded;
+}
+
+//Add a normal deviate of the given standard deviation to every gene
+template <typename Genes, typename Generator>
+bool gaussianMutation(Genes & chromosome, double deviation, Generator & random, double min = -std::numeric_limits<double>::infinity(), double max = std::numeric_limits<double>::infinity())
+{
+	typedef typename Genes::value_type T;
+	
+	std::vector<T> & deviates = randomNumbers<T>(chromosome.size());
+	random.normal(deviates.data(), chromosome.size());
+	
+	const PerturbKernel<T> kernel = { static_cast<T>(deviation), static_cast<T>(min), static_cast<T>(max) };
+	T * arrays[] = { chromosome.data(), deviates.data() };
+	return runRealKernel(kernel, arrays, chromosome.size());
+}
+
+/************************/
+/** Ragged populations **/
+/************************/
+
+//Chromosomes of any length packed one after the other in a single buffer of genes (compressed sparse row layout)
+//The genes of chromosome i are between offsets[i] and offsets[i+1], so copying or serializing a whole population is copying two arrays
+//It is the layout of the populations given by getPopulation(): the algorithm itself keeps one vector per chromosome, reused from a generation to the next
+template <typename T>
+class RaggedPopulation
+{
+	public :
+		
+		RaggedPopulation()
+		 : _offsets(1, 0)
+		{}
+		
+		//Number of chromosomes
+		unsigned size() const
+		{
+			return _offsets.size() - 1;
+		}
+		
+		bool empty() const
+		{
+			return size() == 0;
+		}
+		
+		//Number of genes of a chromosome
+		unsigned length(unsigned index) const
+		{
+			return _offsets[index+1] - _offsets[index];
+		}
+		
+		//Genes of a chromosome
+		T const * genes(unsigned index) const
+		{
+			return _genes.data() + _offsets[index];
+		}
+		
+		T * genes(unsigned index)
+		{
+			return _genes.data() + _offsets[index];
+		}
+		
+		//Remove all the chromosomes (the memory is kept for the next ones)
+		void clear()
+		{
+			_genes.clear();
+			_offsets.resize(1);
+		}
+		
+		//Append a chromosome (a vector, an array or a BitChromosome)
+		template <typename Genes>
+		void push_back(Genes const & chromosome)
+		{
+			const unsigned begin = _genes.size();
+			_genes.resize(begin + chromosome.size());
+			for (unsigned i=0 ; i<chromosome.size() ; i++)
+				_genes[begin + i] = chromosome[i];
+			_offsets.push_back(_genes.size());
+		}
+		
+		//Copy a chromosome into a vector
+		void get(unsigned index, Chromosome<T> & chromosome) const
+		{
+			chromosome.assign(genes(index), genes(index) + length(index));
+		}
+		
+		//The whole buffers (the genes of all the chromosomes, and the size()+1 offsets of the chromosomes in there)
+		std::vector<T> const & allGenes() const
+		{
+			return _genes;
+		}
+		
+		std::vector<unsigned> const & offsets() const
+		{
+			return _offsets;
+		}
+	
+	private :
+		
+		std::vector<T>			_genes;		//The genes of all the chromosomes
+		std::vector<unsigned>	_offsets;	//Where each chromosome starts in _genes, followed by the total number of genes
+};
+
+/*******************/
+/** Fitness cache **/
+/*******************/
+
+//Bounded table of fitness scores indexed by chromosome hashes
+//Only the 64-bit hashes are stored, not the chromosomes: two chromosomes with the same hash share their score (a collision silently gives the score of the other one)
+class FitnessCache
+{
+	public :
+	
+		//Number of slots of a window: a hash can only be stored in the window given by its low bits (set associative table)
+		static const unsigned Window = 8;
+		
+		//Make room for at least capacity scores (0 disables the cache), this empties the cache
+		void resize(unsigned capacity)
+		{
+			std::size_t size = 0;
+			if (capacity > 0)
+			{
+				size = Window;
+				while (size < capacity)
+					size *= 2;
+			}
+			
+			_entries.assign(size, Entry());
+			_hands.assign(size / Window, 0);
+		}
+		
+		//Forget every score
+		void clear()
+		{
+			std::fill(_entries.begin(), _entries.end(), Entry());
+			std::fill(_hands.begin(), _hands.end(), 0);
+		}
+		
+		//Is there room for anything?
+		bool enabled() const
+		{
+			return !_entries.empty();
+		}
+		
+		//Get the score stored for a hash, if any
+		bool find(std::uint64_t hash, Score & score)
+		{
+			Entry * window = this->window(hash);
+			for (unsigned i=0 ; i<Window ; i++)
+			{
+				Entry & entry = window[i];
+				
+				//Entries are never removed, only replaced, so an empty slot ends the search
+				if (!entry.used)
+					return false;
+				
+				if (entry.hash == hash)
+				{
+					entry.referenced = true;
+					score = entry.score;
+					return true;
+				}
+			}
+			
+			return false;
+		}
+		
+		//Store the score of a hash, evicting an old entry of its window if needed
+		void insert(std::uint64_t hash, Score score)
+		{
+			Entry * window = this->window(hash);
+			for (unsigned i=0 ; i<Window ; i++)
+			{
+				Entry & entry = window[i];
+				if (!entry.used || entry.hash == hash)
+				{
+					entry = Entry(hash, score);
+					return;
+				}
+			}
+			
+			//The window is full: clock eviction, the hand of the window gives a second chance to the entries used since its last pass
+			unsigned char & hand = _hands[(window - _entries.data()) / Window];
+			while (true)
+			{
+				Entry & entry = window[hand];
+				hand = (hand + 1) % Window;
+				
+				if (entry.referenced)
+				{
+					entry.referenced = false;
+				}
+				else
+				{
+					entry = Entry(hash, score);
+					return;
+				}
+			}
+		}
+		
+	private :
+	
+		struct Entry
+		{
+			Entry() : hash(0), score(0.0), used(false), referenced(false) {}
+			Entry(std::uint64_t h, Score s) : hash(h), score(s), used(true), referenced(true) {}
+			
+			std::uint64_t	hash;
+			Score			score;
+			bool			used;
+			bool			referenced;
+		};
+		
+		//First slot of the window of a hash
+		Entry * window(std::uint64_t hash)
+		{
+			return _entries.data() + (hash & (_entries.size() - 1) & ~(std::uint64_t)(Window - 1));
+		}
+		
+		std::vector<Entry>			_entries;	//The table (its size is a power of two, made of windows of Window slots)
+		std::vector<unsigned char>	_hands;		//Position of the clock hand of each window
+};
+
+/****************************/
+/** Algorithm declarations **/
+/****************************/
+
+template <typename Algorithm>
+class IslandModel;
+
+template <typename Algorithm>
+class ProcessIsland;
+
+//Genetic algorithm on chromosomes of genes of type T: N genes stored inline in each chromosome, or a length chosen at run time if N is 0
+//The functions of the user are found at compile time in the Derived class (curiously recurring template pattern), so they can be inlined in the loops over the genes
+//Derived must define T randomGene() const and Score score(ChromosomeType const &) const, and can hide the other functions called through derived() (as public members)
+template <typename Derived, typename T, std::size_t N = 0>
+class StaticGeneticAlgorithm
+{
+	template <typename Algorithm>
+	friend class IslandModel;
+	
+	template <typename Algorithm>
+	friend class ProcessIsland;
+	
+	//Everything the user needs should be here, in the public section
+	public :
+		
+		//Type of the genes
+		typedef T GeneType;
+		
+		//Length of the chromosomes if it is fixed at compile time (0 if it varies)
+		static const std::size_t ChromosomeLength = N;
+		
+		//Type of the chromosomes (Chromosome<T> if the length varies, std::array<T, N> otherwise) and of the populations
+		typedef typename ChromosomeTraits<T, N>::Type ChromosomeType;
+		typedef std::vector<ChromosomeType> PopulationType;
+		
+		//The class running the algorithm, whatever the class of the user derives from
+		typedef StaticGeneticAlgorithm<Derived, T, N> EngineType;
+		
+		/*-----------------------*/
+		/* Constructor and stuff */
+		/*-----------------------*/
+		
+		//Init default values, etc
+		StaticGeneticAlgorithm();
+		
+		/*-----------------------------*/
+		/* Main functions for the user */
+		/*-----------------------------*/
+		
+		//Run the algorithm until it ends or until the user stops it
+		void run(bool blocking, bool enableLogging = false, std::ostream & outputStream = std::cout);
+		
+		//Stop the algorithm
+		void stop();
+		
+		//Get the best chromosome
+		ChromosomeType best();
+		
+		//Get the score of the best chromosome
+		Score bestScore();
+		
+		//Get a copy of the last evaluated generation, packed in a single buffer and sorted from the best chromosome to the worst, with their scores
+		void getPopulation(RaggedPopulation<T> & population, std::vector<Score> & scores);
+		
+		//Set the ending criterion (with optional parameters if the user chooses MaxScore or BestScore)
+		void setEndingCriterion(EndingCriterion type, Score maxScoreForMaxScoreCriterion = 0.0, unsigned numberOfGenerationsWithoutImprovementForBestScoreCriterion = 10, Score absoluteImprovementForBestScoreCriterion = 0.0, Score relativeImprovementForBestScoreCriterion = 0.0);
+		
+		//Set the selection type (with optional parameter if the user chooses Tournament)
+		void setSelectionType(SelectionType type, unsigned numberOfChromosomesForTournament = 0);
+		
+		//Set the crossover type (with optional parameters if the user chooses Blend or SimulatedBinary, which need floating point genes)
+		void setCrossoverType(CrossoverType type, double alphaForBlendCrossover = 0.5, double distributionIndexForSimulatedBinaryCrossover = 2.0);
+		
+		//Set the mutation type (with optional parameter if the user chooses Gaussian, which needs floating point genes)
+		void setMutationType(MutationType type, double standardDeviationForGaussianMutation = 0.1);
+		
+		//Keep the floating point genes produced by the Blend and SimulatedBinary crossovers and the Gaussian mutation between min and max
+		void setGeneBounds(double min, double max);
+		
+		//Make the chromosomes permutations of the integers from 0 to their size-1 (random permutations instead of randomGene() at the start)
+		//They need a fixed size, a PartiallyMapped, Ordered or Cycle crossover and a Swap, Insertion or Inversion mutation
+		void setPermutations(bool enable);
+		
+		//Set the population size and mutation probability
+		void setMainParameters(unsigned populationSize, double mutationProbability);
+		
+		//Set the chromosomes size
+		void setChromosomesSize(unsigned min, unsigned max); //Just enter the same number on min and max for a constant length (or use GeneticAlgorithm<T, N>)
+		
+		//Evaluate the fitness scores of each generation on a pool of threads (0 thread means one per hardware core)
+		void setParallelEvaluation(bool enable, unsigned numberOfThreads = 0, unsigned chunkSize = 0);
+		
+		//Remember the scores of up to capacity chromosomes so that duplicates are not evaluated again (0 disables the cache)
+		void setFitnessCache(unsigned capacity);
+		
+		//Copy the numberOfElites best chromosomes unchanged into the next generation
+		void setElitism(unsigned numberOfElites);
+		
+		//Seed the random numbers of the algorithm so that every run gives the same results (whatever the number of threads)
+		void setSeed(std::uint64_t seed);
+		
+		//Replace the generations with numberOfThreads threads breeding, evaluating and inserting children continuously (0 thread means one per hardware core)
+		void setSteadyState(bool enable, unsigned numberOfThreads = 0, ReplacementType replacement = ReplacementType::Worst);
+		
+		//End the algorithm when the budgets are exhausted, in addition to the ending criterion (0 means no limit and NaN no target score)
+		//The budgets are also checked during the evaluation of a generation, which then stops early
+		void setBudgets(double maxSeconds, double maxProcessorSeconds = 0.0, unsigned long long maxEvaluations = 0, unsigned maxGenerations = 0, Score targetScore = std::numeric_limits<Score>::quiet_NaN(), BudgetCombination combination = BudgetCombination::Any);
+		
+		/*---------------------------*/
+		/* Useful stuff for the user */
+		/*---------------------------*/
+		
+		unsigned getNumberOfGenerations() const;
+		
+		//Get the seed of the last run (give it to setSeed() to replay the run)
+		std::uint64_t getSeed() const;
+		
+		//Number of scores taken from the fitness cache and number of scores actually computed while it was enabled (reset by run())
+		unsigned long long getNumberOfCacheHits() const;
+		unsigned long long getNumberOfCacheMisses() const;
+		
+		//Number of chromosomes given to the fitness function since the beginning of the last run
+		unsigned long long getNumberOfEvaluations() const;
+		
+		/*----------------------------------------*/
+		/* Functions the user may want to rewrite */
+		/*----------------------------------------*/
+		
+		//Chromosome to string (returns empty string by default)
+		std::string print(ChromosomeType const & chromosome) const {return std::string();}
+		
+		//Compute the scores of count contiguous chromosomes at once (calls score() on each of them by default)
+		void scoreBatch(ChromosomeType const * chromosomes, Score * scores, unsigned count) const;
+		
+		//Hash a chromosome for the fitness cache (uses std::hash on each gene by default)
+		std::uint64_t chromosomeHash(ChromosomeType const & chromosome) const;
+		
+		//Estimate how long the evaluation of a chromosome takes, in any unit (0 by default, ie. unknown)
+		//With the parallel evaluation, the most expensive chromosomes are evaluated first so that no thread ends up alone with a long one
+		double evaluationCost(ChromosomeType const & chromosome) const {return 0.0;}
+	
+	
+	//The protected section contains the magic
+	protected :
+	
+		#ifndef DISABLE_NONBLOCKING_MODE
+		
+		//Part of the chromosomes replaced by the Worst replacement of the steady state mode
+		struct WorstShard
+		{
+			std::mutex				mutex;	//Protects the heap
+			std::vector<unsigned>	heap;	//Indices of the _offspring in a binary heap whose top is the worst chromosome of the shard
+			std::atomic<Score>		top;	//Score of the top of the heap (read without locking to find the worst shard)
+		};
+		
+		#endif
+		
+		/*------------*/
+		/* Attributes */
+		/*------------*/
+		
+		/* Parameters */
+
+		unsigned 		_populationSize;		//Size of the population (default is 100)
+		EndingCriterion _endCriterion;			//Criterion to end algorithm (default is BestScore)
+		SelectionType 	_selectionType;			//Selection type (default is Tournament)
+		double 			_mutationProbability;	//Mutation probabiliy (default is 0.01)
+		Score 			_maxEndScore;			//Maximum score to reach (only used with MaxScore)
+		unsigned		_steadyGenerations;		//The number of generations without improvement before the algorithm stops (only used with BestScore, default is 10)
+		Score			_absoluteImprovement;	//How much the best score must increase to count as an improvement (only used with BestScore, default is 0)
+		Score			_relativeImprovement;	//Same, relative to the magnitude of the best score (only used with BestScore, default is 0)
+		unsigned 		_tournamentSize;		//Size for tournament selection (default is 10)
+		CrossoverType	_crossoverType;			//Crossover type (default is Segments)
+		double			_blendAlpha;			//Enlargement of the intervals of the genes (only used with Blend, default is 0.5)
+		double			_distributionIndex;		//Spread of the children around their parents (only used with SimulatedBinary, default is 2)
+		MutationType	_mutationType;			//Mutation type (default is RandomGenes)
+		double			_mutationDeviation;		//Standard deviation of the noise added to the genes (only used with Gaussian, default is 0.1)
+		double			_minGene;				//Bounds of the genes produced by the real-valued operators (default is -infinity and +infinity)
+		double			_maxGene;
+		bool			_permutations;			//The chromosomes are permutations (default is false)
+		unsigned		_minChromosomeSize;		//Minimum size for a chromosome (default is 1, or N)
+		unsigned		_maxChromosomeSize;		//Maximum size for a chromosome (default is 100, or N)
+		bool			_parallelEvaluation;	//Evaluate the population on _threadPool (default is false)
+		unsigned		_evaluationThreads;		//Number of threads of _threadPool (default is 0, ie. the hardware concurrency)
+		unsigned		_evaluationChunkSize;	//Number of chromosomes a thread evaluates at once (default is 0, ie. about 8 chunks per thread)
+		unsigned		_cacheCapacity;			//Number of scores the _cache can hold (default is 0, ie. no cache)
+		unsigned		_elitism;				//Number of best chromosomes kept unchanged in the next generation (default is 0)
+		bool			_seeded;				//Use _seed for each run (default is false, ie. a new random seed for each run)
+		std::uint64_t	_seed;					//Seed of the random numbers of the current run
+		bool			_steadyState;			//Breed without generations after the first one (default is false)
+		unsigned		_steadyStateThreads;	//Number of threads breeding in the steady state mode (default is 0, ie. the hardware concurrency)
+		ReplacementType	_replacementType;		//Chromosome replaced by a child in the steady state mode (default is Worst)
+		double			_maxSeconds;			//Budget of wall-clock time for a run (default is 0, ie. no limit)
+		double			_maxProcessorSeconds;	//Budget of processor time of the whole process for a run (default is 0, ie. no limit)
+		unsigned long long _maxEvaluations;		//Budget of evaluations (default is 0, ie. no limit)
+		unsigned		_maxGenerations;		//Budget of generations, the first one included (default is 0, ie. no limit)
+		Score			_targetScore;			//Score ending the algorithm once a chromosome reaches it (default is NaN, ie. no target)
+		BudgetCombination _budgetCombination;	//Whether any or all of the budgets have to be exhausted (default is Any)
+
+		/* Things the algorithm needs for reasons */
+
+		PopulationType							_population;	//The actual population (chromosomes are stored contiguously and addressed by index)
+		std::vector<Score>						_scores;		//The fitness scores of the _population (same indices)
+		std::vector<unsigned>					_ranking;		//Indices of the _population sorted by ascending score (rebuilt once per generation)
+		std::vector<Score>						_cumulativeScores;	//Accumulated scores along the _ranking, for fitness proportionate selections (rebuilt once per generation)
+		PopulationType							_offspring;		//The next generation, built over the chromosomes of the one before the _population (the two buffers swap their roles each generation)
+		std::vector<Score>						_offspringScores;	//Scores of the _offspring which are already known
+		std::vector<bool>						_offspringModified;	//Which chromosomes of the _offspring have changed since they were evaluated
+		std::vector<bool>						_offspringScored;	//Which chromosomes of the _offspring have a score (the budgets can stop the evaluation of a generation)
+		std::vector<unsigned>					_scoredChildren;	//Children scored before the budgets stopped the evaluation of their generation, best first
+		std::vector<unsigned>					_selection;		//Indices of the selected parents
+		ChromosomeType							_spareChild;	//Where the second child goes when there's room for one child only
+		Score									_recordScore;	//Best score so far, for the BestScore ending criterion
+		unsigned								_stagnation;	//Number of generations since the _recordScore improved (~0u before the first generation)
+		FitnessCache							_cache;			//Scores of the chromosomes seen recently
+		unsigned long long						_cacheHits;		//Number of scores found in the _cache
+		unsigned long long						_cacheMisses;	//Number of scores computed while the _cache was enabled
+		std::vector<std::uint64_t>				_hashes;		//Hashes of the population being evaluated
+		std::vector<unsigned>					_toEvaluate;	//Indices of the population missing from the _cache
+		PopulationType							_batch;			//Chromosomes missing from the _cache, gathered to be evaluated in one batch
+		std::vector<Score>						_batchScores;	//Scores of the _batch
+		std::vector<unsigned>					_batchOrder;	//Positions in _toEvaluate of the chromosomes of the _batch
+		std::vector<double>						_costs;			//Estimated evaluation costs of the _toEvaluate chromosomes
+		std::vector<unsigned char>				_scored;		//Which chromosomes given to scorePopulation() were scored (one byte each so that the threads can write them at the same time)
+		std::atomic<bool>						_run;			//Boolean used to stop the algorithm if needed
+		unsigned								_generation;	//To keep track of the number of generations
+		std::chrono::steady_clock::time_point	_startTime;		//When the current run started (once its first population was created)
+		std::clock_t							_startClock;	//Processor time used by the process when the current run started (same)
+		std::atomic<unsigned long long>			_evaluations;	//Number of chromosomes given to scoreBatch() during the current run
+		std::atomic<unsigned>					_timedBatch;	//Size of the batches given to scoreBatch() with a budget of time (kept from a chunk and a generation to the next)
+		std::atomic<bool>						_targetReached;	//A chromosome reached the _targetScore during the current run
+		#ifndef DISABLE_NONBLOCKING_MODE
+		std::mutex								_mutex;			//For thread safety
+		std::unique_ptr<ThreadPool>				_threadPool;	//Workers used for parallel evaluation (kept alive between generations)
+		std::unique_ptr<std::mutex[]>			_slotMutexes;	//One mutex per chromosome of the _offspring in the steady state mode
+		std::unique_ptr<std::atomic<Score>[]>	_slotScores;	//Scores of the _offspring in the steady state mode (read without locking to choose the parents and the replaced chromosomes)
+		std::unique_ptr<WorstShard[]>			_worstShards;	//The _offspring dealt to a few heaps whose tops are their worst chromosomes (steady state mode with the Worst replacement)
+		unsigned								_numberOfWorstShards;	//Number of _worstShards (a few per thread, at most one per chromosome)
+		std::atomic<unsigned long long>			_births;		//Number of children bred in the steady state mode
+		#endif
+		
+		/* Logging variables */
+		
+		bool 									_logEnable;		//Enable or disable logging to _logStream.
+		std::reference_wrapper<std::ostream> 	_logStream;		//The output stream to write messages to.
+		
+		/*----------------*/
+		/* Core functions */
+		/*----------------*/
+		
+		//The class of the user, whose functions replace the ones of this class
+		Derived & derived() {return static_cast<Derived &>(*this);}
+		Derived const & derived() const {return static_cast<Derived const &>(*this);}
+		
+		//Check the parameters, reset everything and create a random population in the _offspring
+		void prepare();
+		
+		//Make the population evolve until an ending criterion is reached or the user stops the algorithm
+		void evolve();
+		
+		//Evaluate the _offspring and make it the _population: returns true if the ending criterion is reached
+		bool evaluateGeneration();
+		
+		//Put the children scored before the budgets stopped the evaluation into the _population instead of the whole _offspring
+		//They replace the worst chromosomes of the last evaluated generation when they are better (they make the first generation on their own)
+		void keepScoredChildren();
+		
+		//Breed the next generation from the _population
+		void nextGeneration();
+		
+		#ifndef DISABLE_NONBLOCKING_MODE
+		
+		//Breed children continuously in the _offspring from the evaluated _population until the end (no generation, no barrier between the threads)
+		void evolveSteadyState();
+		
+		//Breed two children at a time, evaluate them and insert them into the _offspring until the end (run by each thread)
+		void breedSteadyState();
+		
+		//Pick a random chromosome of the _offspring, the best or the worst of a tournament of the given size
+		unsigned steadyStateTournament(RandomStream & random, unsigned size, bool best) const;
+		
+		//Move the top of a heap of the _worstShards down to its place after its score increased (the mutex of its shard must be locked)
+		void siftWorstHeap(std::vector<unsigned> & heap);
+		
+		//Copy the _offspring to the _population and rank it, then log the generation and check the ending criterion if asked
+		//(the generations of the steady state mode are made of _populationSize children) returns true if the ending criterion is reached
+		bool publishSteadyState(bool endOfGeneration);
+		
+		#endif
+		
+		//Log the result and mark the algorithm as stopped
+		void finish();
+		
+		//Build the _offspring from the _population (selection, recombination and mutation)
+		void breed();
+		
+		//Restart the random numbers at the stream of an operator applied on an individual (or a pair) of a generation
+		void useRandomStream(unsigned generation, unsigned index, GeneticOperator geneticOperator) const;
+		
+		//Random numbers of the genetic operators, restarted by useRandomStream() for each operation on each individual (each thread has its own stream)
+		static RandomStream & randomStream();
+		
+		//Compute the fitness scores of the modified chromosomes of a population (in parallel if enabled, using the cache if enabled)
+		//Tells which chromosomes have a score in scored and returns how many were left without one because the budgets stopped the evaluation
+		unsigned evaluatePopulation(PopulationType & population, std::vector<Score> & scores, std::vector<bool> const & modified, std::vector<bool> & scored);
+		
+		//Compute the fitness scores of a population without looking at the cache (same return value, the scored chromosomes are marked in _scored)
+		unsigned scorePopulation(PopulationType const & population, std::vector<Score> & scores);
+		
+		//Score count contiguous chromosomes, or only the first ones if a budget is exhausted (the others get a NaN score), returns how many were scored
+		//The budgets are checked before each batch given to scoreBatch(): all the chromosomes at once, or batches of about a millisecond with a budget of time
+		unsigned scoreWithinBudgets(ChromosomeType const * chromosomes, Score * scores, unsigned count);
+		
+		//Check if the budgets end the algorithm, given the number of generations entirely evaluated
+		bool budgetsExhausted(unsigned completedGenerations) const;
+		
+		//Tell if a budget other than the generations is set (they are the ones checked during the evaluation)
+		bool hasEvaluationBudgets() const;
+		
+		//The four following functions are the policies of the algorithm: a Derived class can replace them with its own public ones
+		//(they get their random numbers from randomStream(), which is already restarted for the individual they work on)
+		
+		//Check if an ending criterion is reached
+		bool isEvolutionOver(); //Non-const for a minor reason
+		
+		//Select chromosomes to be crossed (selection): appends their indices in the _population to selection
+		void select(std::vector<unsigned> & selection) const;
+		
+		//Cross 2 chromosomes (recombination): the children are written over firstChild and secondChild, returns true if a gene was actually exchanged
+		bool cross(ChromosomeType const & first, ChromosomeType const & second, ChromosomeType & firstChild, ChromosomeType & secondChild) const;
+		
+		//Make a chromosome change with a user-defined probability (mutation): returns true if a gene was actually changed
+		bool mutate(ChromosomeType & chromosome) const;
+		
+		//Replace the genes between begin and end (excluded) with random ones (with randomGene(), or with random words for the bits)
+		bool replaceGenes(ChromosomeType & chromosome, unsigned begin, unsigned end, RandomStream & random, std::false_type) const;
+		bool replaceGenes(ChromosomeType & chromosome, unsigned begin, unsigned end, RandomStream & random, std::true_type) const;
+		
+		//Mix the first size genes of two children with the Blend or SimulatedBinary crossover (floating point genes only)
+		bool mixGenes(ChromosomeType & first, ChromosomeType & second, unsigned size, RandomStream & random, std::true_type) const;
+		bool mixGenes(ChromosomeType & first, ChromosomeType & second, unsigned size, RandomStream & random, std::false_type) const;
+		
+		//Mutate each gene with a probability of _mutationProbability (replaced with randomGene(), or flipped for the bits), skipping directly to the next mutated gene
+		bool mutateGenes(ChromosomeType & chromosome, RandomStream & random, std::false_type) const;
+		bool mutateGenes(ChromosomeType & chromosome, RandomStream & random, std::true_type) const;
+		
+		//Add Gaussian noise to all the genes of a chromosome (floating point genes only)
+		bool perturbGenes(ChromosomeType & chromosome, RandomStream & random, std::true_type) const;
+		bool perturbGenes(ChromosomeType & chromosome, RandomStream & random, std::false_type) const;
+		
+		//Recombine two permutations with the PartiallyMapped, Ordered or Cycle crossover (integer genes only)
+		bool crossPermutations(ChromosomeType const & first, ChromosomeType const & second, ChromosomeType & firstChild, ChromosomeType & secondChild, unsigned size, RandomStream & random, std::true_type) const;
+		bool crossPermutations(ChromosomeType const & first, ChromosomeType const & second, ChromosomeType & firstChild, ChromosomeType & secondChild, unsigned size, RandomStream & random, std::false_type) const;
+		
+		//Fill a chromosome with a random permutation (integer genes only)
+		void fillPermutation(ChromosomeType & chromosome, RandomStream & random, std::true_type) const;
+		void fillPermutation(ChromosomeType & chromosome, RandomStream & random, std::false_type) const;
+				
+		/*--------------------------------*/
+		/* Useful stuff for the algorithm */
+		/*--------------------------------*/
+		
+		//Generate a random chromosome
+		ChromosomeType randomChromosome() const;
+		
+		//Sort the indices of the _population by ascending score into _ranking and accumulate the scores into _cumulativeScores
+		void rankPopulation();
+		
+		//Get the score of the chromosome at position index in the _population
+		Score score(unsigned index) const;
+		
+		//Get the accumulation of all scores of the _population
+		Score totalScore() const;
+		
+		//Get the index in the _population of the first chromosome whose accumulated fitness score exceeds the required fitness
+		unsigned individual(Score fitness) const;
+		
+		//Get the chromosome at position index in the _population
+		ChromosomeType chromosome(unsigned index) const;
+		
+		//Get the last element of the ranking, ie. the best chromosome (its score is _scores[_ranking.back()])
+		ChromosomeType const & lastElement() const;
+		
+		//Give the count best chromosomes of the _population to send(chromosome, score) (for the migrations between populations)
+		template <typename Send>
+		void emigrate(unsigned count, Send send) const;
+		
+		//Replace the worst chromosomes of the _population with the ones given by receive(chromosome, score) until it returns false (count at most)
+		//The chromosome given to receive() is the one being replaced, it can be swapped
+		template <typename Receive>
+		unsigned immigrate(unsigned count, Receive receive);
+	
+};
+
+//Genetic algorithm whose functions of the user are virtual: derive from it and implement randomGene() and score()
+//(thin adapter over StaticGeneticAlgorithm, which calls the virtual functions once per gene or chromosome)
+template <typename T, std::size_t N = 0>
+class GeneticAlgorithm : public StaticGeneticAlgorithm<GeneticAlgorithm<T, N>, T, N>
+{
+	typedef StaticGeneticAlgorithm<GeneticAlgorithm<T, N>, T, N> Base;
+	
+	public :
+		
+		typedef typename Base::ChromosomeType ChromosomeType;
+		typedef typename Base::PopulationType PopulationType;
+		
+		/*----------------------------------------------------*/
+		/* Functions which have to be implemented by the user */
+		/*----------------------------------------------------*/
+		
+		//Generate a random value of type T
+		virtual T randomGene() const = 0;
+		
+		//Compute the score of a chromosome
+		virtual Score score(ChromosomeType const & chromosome) const = 0;
+		
+		/*----------------------------------------*/
+		/* Functions the user may want to rewrite */
+		/*----------------------------------------*/
+		
+		//Chromosome to string (returns empty string by default)
+		virtual std::string print(ChromosomeType const & chromosome) const {return std::string();}
+		
+		//Compute the scores of count contiguous chromosomes at once (calls score() on each of them by default)
+		virtual void scoreBatch(ChromosomeType const * chromosomes, Score * scores, unsigned count) const {Base::scoreBatch(chromosomes, scores, count);}
+		
+		//Hash a chromosome for the fitness cache (uses std::hash on each gene by default)
+		virtual std::uint64_t chromosomeHash(ChromosomeType const & chromosome) const {return Base::chromosomeHash(chromosome);}
+		
+		//Estimate how long the evaluation of a chromosome takes, in any unit (0 by default, ie. unknown)
+		//With the parallel evaluation, the most expensive chromosomes are evaluated first so that no thread ends up alone with a long one
+		virtual double evaluationCost(ChromosomeType const & chromosome) const {return 0.0;}
+	
+	protected :
+		
+		using Base::score;
+};
+
+/******************************/
+/** Algorithm implementation **/
+/******************************/
+
+/*-----------------------*/
+/* Constructor and stuff */
+/*-----------------------*/
+
+template <typename Derived, typename T, std::size_t N>
+StaticGeneticAlgorithm<Derived, T, N>::StaticGeneticAlgorithm()
+ : _logStream(std::cout)
+{
+	//Default parameters
+	_populationSize = 100;
+	_mutationProbability = 0.01;
+	_endCriterion = EndingCriterion::BestScore;
+	_steadyGenerations = 10;
+	_absoluteImprovement = 0.0;
+	_relativeImprovement = 0.0;
+	_selectionType = SelectionType::Tournament;
+	_tournamentSize = 10;
+	_crossoverType = CrossoverType::Segments;
+	_blendAlpha = 0.5;
+	_distributionIndex = 2.0;
+	_mutationType = MutationType::RandomGenes;
+	_mutationDeviation = 0.1;
+	_minGene = -std::numeric_limits<double>::infinity();
+	_maxGene = std::numeric_limits<double>::infinity();
+	_permutations = false;
+	_run = false;
+	_minChromosomeSize = N > 0 ? N : 1;
+	_maxChromosomeSize = N > 0 ? N : 100;
+	_parallelEvaluation = false;
+	_evaluationThreads = 0;
+	_evaluationChunkSize = 0;
+	_steadyState = false;
+	_steadyStateThreads = 0;
+	_replacementType = ReplacementType::Worst;
+	_maxSeconds = 0.0;
+	_maxProcessorSeconds = 0.0;
+	_maxEvaluations = 0;
+	_maxGenerations = 0;
+	_targetScore = std::numeric_limits<Score>::quiet_NaN();
+	_budgetCombination = BudgetCombination::Any;
+	_cacheCapacity = 0;
+	_cacheHits = 0;
+	_cacheMisses = 0;
+	_elitism = 0;
+	_seeded = false;
+	_seed = 0;
+	
+	//Other
+	_logEnable = false;
+}
+
+/*-----------------------------*/
+/* Main functions for the user */
+/*-----------------------------*/
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::run(bool blocking, bool enableLogging, std::ostream & outputStream)
+{
+	//Logging
+	_logEnable = enableLogging;
+	_logStream = std::ref(outputStream);
+	
+	prepare();
+	
+	if (blocking)
+	{
+		//Just run evolve
+		evolve();
+	}
+	else
+	{
+		#ifdef DISABLE_NONBLOCKING_MODE
+		
+		throw std::runtime_error("Cannot run in nonblocking mode because it is disabled");
+		
+		#else
+		
+		//Make the population evolve in a new thread
+		std::thread evolution(&StaticGeneticAlgorithm<Derived, T, N>::evolve, this);
+		
+		//Detach the thread from its parent thread
+		evolution.detach();
+		
+		#endif
+	}
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::prepare()
+{
+	//Safety check
+	if (_selectionType == SelectionType::Tournament && _tournamentSize > _populationSize)
+	{
+		throw std::runtime_error("The tournament size cannot be greater than the population size");
+	}
+	
+	if (_steadyState && _populationSize == 0)
+		throw std::runtime_error("The steady state mode needs a population to breed from");
+	
+	if (_permutations)
+	{
+		if (_minChromosomeSize != _maxChromosomeSize)
+			throw std::runtime_error("The permutations must have a fixed size");
+		
+		if (_crossoverType != CrossoverType::PartiallyMapped && _crossoverType != CrossoverType::Ordered && _crossoverType != CrossoverType::Cycle)
+			throw std::runtime_error("The permutations need the PartiallyMapped, Ordered or Cycle crossover");
+		
+		if (_mutationType != MutationType::Swap && _mutationType != MutationType::Insertion && _mutationType != MutationType::Inversion)
+			throw std::runtime_error("The permutations need the Swap, Insertion or Inversion mutation");
+	}
+	
+	//Start the workers now so that they are ready for the first generation
+	#ifndef DISABLE_NONBLOCKING_MODE
+	if (_parallelEvaluation || _steadyState)
+	{
+		const unsigned requested = _steadyState ? _steadyStateThreads : _evaluationThreads;
+		const unsigned threads = requested > 0 ? requested : std::max(std::thread::hardware_concurrency(), 1u);
+		if (!_threadPool || _threadPool->size() != threads)
+			_threadPool.reset(new ThreadPool(threads));
+	}
+	#endif
+	
+	//Start with an empty cache (the fitness function may depend on things that changed since the last run)
+	_cache.resize(_cacheCapacity);
+	_cacheHits = 0;
+	_cacheMisses = 0;
+	
+	//Every random number of the run derives from the seed (keep the user's seed, or pick a new one)
+	if (!_seeded)
+		_seed = Random::engine()();
+	LOG("Random seed: " << _seed);
+	
+	//Forget the generations of the last run (best() has nothing to give until the first generation is evaluated)
+	{
+		#ifndef DISABLE_NONBLOCKING_MODE
+		std::lock_guard<std::mutex> lock(_mutex);
+		#endif
+		_ranking.clear();
+	}
+	
+	//Reset stuff
+	_recordScore = std::numeric_limits<Score>::quiet_NaN();
+	_stagnation = ~0u;
+	_run = true;
+	_generation = 0;
+	_evaluations = 0;
+	_timedBatch = 1;
+	_targetReached = false;
+	
+	//Create population (the first generation has to be evaluated entirely)
+	_offspring.resize(_populationSize);
+	_offspringScores.assign(_populationSize, 0.0);
+	_offspringModified.assign(_populationSize, true);
+	
+	for (unsigned i=0 ; i<_populationSize ; i++)
+	{
+		useRandomStream(0, i, GeneticOperator::Initialization);
+		_offspring[i] = randomChromosome();
+	}
+	
+	//The budgets of time start once the population is created, so that a long initialization can't leave the first generation without a score
+	_startTime = std::chrono::steady_clock::now();
+	_startClock = std::clock();
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::stop()
+{
+	LOG("User stopped the algorithm");
+	_run = false;
+	_logEnable = false;
+}
+
+template <typename Derived, typename T, std::size_t N>
+typename StaticGeneticAlgorithm<Derived, T, N>::ChromosomeType StaticGeneticAlgorithm<Derived, T, N>::best()
+{
+	//This function could likely be called from another thread so let's be thread-safe
+	
+	#ifndef DISABLE_NONBLOCKING_MODE
+	_mutex.lock();
+	#endif
+	
+	ChromosomeType best = _ranking.empty() ? ChromosomeTraits<T, N>::create(0) : lastElement();
+		
+	#ifndef DISABLE_NONBLOCKING_MODE
+	_mutex.unlock();
+	#endif
+	
+	return best;
+}
+
+template <typename Derived, typename T, std::size_t N>
+Score StaticGeneticAlgorithm<Derived, T, N>::bestScore()
+{
+	#ifndef DISABLE_NONBLOCKING_MODE
+	std::lock_guard<std::mutex> lock(_mutex);
+	#endif
+	
+	return _ranking.empty() ? 0.0 : _scores[_ranking.back()];
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::getPopulation(RaggedPopulation<T> & population, std::vector<Score> & scores)
+{
+	#ifndef DISABLE_NONBLOCKING_MODE
+	std::lock_guard<std::mutex> lock(_mutex);
+	#endif
+	
+	population.clear();
+	scores.clear();
+	for (unsigned i=_ranking.size() ; i>0 ; i--)
+	{
+		population.push_back(_population[_ranking[i-1]]);
+		scores.push_back(_scores[_ranking[i-1]]);
+	}
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setEndingCriterion(EndingCriterion type, Score maxScoreForMaxScoreCriterion, unsigned numberOfGenerationsWithoutImprovementForBestScoreCriterion, Score absoluteImprovementForBestScoreCriterion, Score relativeImprovementForBestScoreCriterion)
+{
+	if (type == EndingCriterion::MaxScore)
+	{
+		_maxEndScore = maxScoreForMaxScoreCriterion;
+	}
+	else if (type == EndingCriterion::BestScore)
+	{
+		if (absoluteImprovementForBestScoreCriterion < 0 || relativeImprovementForBestScoreCriterion < 0)
+			throw std::runtime_error("The improvements of the BestScore criterion can't be negative");
+		
+		_steadyGenerations = numberOfGenerationsWithoutImprovementForBestScoreCriterion;
+		_absoluteImprovement = absoluteImprovementForBestScoreCriterion;
+		_relativeImprovement = relativeImprovementForBestScoreCriterion;
+	}
+	
+	_endCriterion = type;
+}	
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setSelectionType(SelectionType type, unsigned numberOfChromosomesForTournament)
+{
+	if (type == SelectionType::Tournament)
+	{
+		_tournamentSize = numberOfChromosomesForTournament;
+	}
+	
+	_selectionType = type;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setCrossoverType(CrossoverType type, double alphaForBlendCrossover, double distributionIndexForSimulatedBinaryCrossover)
+{
+	if ((type == CrossoverType::Blend || type == CrossoverType::SimulatedBinary) && !std::is_floating_point<T>::value)
+		throw std::runtime_error("The Blend and SimulatedBinary crossovers need floating point genes");
+	
+	if ((type == CrossoverType::PartiallyMapped || type == CrossoverType::Ordered || type == CrossoverType::Cycle) && !std::is_integral<T>::value)
+		throw std::runtime_error("The PartiallyMapped, Ordered and Cycle crossovers need integer genes");
+	
+	if (type == CrossoverType::Blend)
+	{
+		_blendAlpha = alphaForBlendCrossover;
+	}
+	else if (type == CrossoverType::SimulatedBinary)
+	{
+		_distributionIndex = distributionIndexForSimulatedBinaryCrossover;
+	}
+	
+	_crossoverType = type;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setMutationType(MutationType type, double standardDeviationForGaussianMutation)
+{
+	if (type == MutationType::Gaussian)
+	{
+		if (!std::is_floating_point<T>::value)
+			throw std::runtime_error("The Gaussian mutation needs floating point genes");
+		
+		_mutationDeviation = standardDeviationForGaussianMutation;
+	}
+	
+	_mutationType = type;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setGeneBounds(double min, double max)
+{
+	if (!std::is_floating_point<T>::value)
+		throw std::runtime_error("The gene bounds need floating point genes");
+	
+	if (min > max)
+		throw std::runtime_error("The minimum gene cannot be greater than the maximum gene");
+	
+	_minGene = min;
+	_maxGene = max;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setPermutations(bool enable)
+{
+	if (enable && !std::is_integral<T>::value)
+		throw std::runtime_error("The permutations need integer genes");
+	
+	_permutations = enable;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setMainParameters(unsigned populationSize, double mutationProbability)
+{
+	_populationSize = populationSize;
+	_mutationProbability = mutationProbability;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setChromosomesSize(unsigned min, unsigned max)
+{
+	if (N > 0 && (min != N || max != N))
+		throw std::runtime_error("The chromosomes have a fixed length, they can't have another size");
+	
+	_minChromosomeSize = min;
+	_maxChromosomeSize = max;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setParallelEvaluation(bool enable, unsigned numberOfThreads, unsigned chunkSize)
+{
+	#ifdef DISABLE_NONBLOCKING_MODE
+	
+	if (enable)
+		throw std::runtime_error("Cannot evaluate in parallel because the nonblocking mode is disabled");
+	
+	#endif
+	
+	_parallelEvaluation = enable;
+	_evaluationThreads = numberOfThreads;
+	_evaluationChunkSize = chunkSize;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setFitnessCache(unsigned capacity)
+{
+	_cacheCapacity = capacity;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setElitism(unsigned numberOfElites)
+{
+	_elitism = numberOfElites;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setSeed(std::uint64_t seed)
+{
+	_seeded = true;
+	_seed = seed;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setSteadyState(bool enable, unsigned numberOfThreads, ReplacementType replacement)
+{
+	#ifdef DISABLE_NONBLOCKING_MODE
+	
+	if (enable)
+		throw std::runtime_error("Cannot run in steady state mode because the nonblocking mode is disabled");
+	
+	#endif
+	
+	_steadyState = enable;
+	_steadyStateThreads = numberOfThreads;
+	_replacementType = replacement;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::setBudgets(double maxSeconds, double maxProcessorSeconds, unsigned long long maxEvaluations, unsigned maxGenerations, Score targetScore, BudgetCombination combination)
+{
+	if (maxSeconds < 0 || maxProcessorSeconds < 0)
+		throw std::runtime_error("The time budgets can't be negative");
+	
+	_maxSeconds = maxSeconds;
+	_maxProcessorSeconds = maxProcessorSeconds;
+	_maxEvaluations = maxEvaluations;
+	_maxGenerations = maxGenerations;
+	_targetScore = targetScore;
+	_budgetCombination = combination;
+}
+
+/*---------------------------*/
+/* Useful stuff for the user */
+/*---------------------------*/
+
+template <typename Derived, typename T, std::size_t N>
+unsigned StaticGeneticAlgorithm<Derived, T, N>::getNumberOfGenerations() const
+{
+	return _generation;
+}
+
+template <typename Derived, typename T, std::size_t N>
+std::uint64_t StaticGeneticAlgorithm<Derived, T, N>::getSeed() const
+{
+	return _seed;
+}
+
+template <typename Derived, typename T, std::size_t N>
+unsigned long long StaticGeneticAlgorithm<Derived, T, N>::getNumberOfCacheHits() const
+{
+	return _cacheHits;
+}
+
+template <typename Derived, typename T, std::size_t N>
+unsigned long long StaticGeneticAlgorithm<Derived, T, N>::getNumberOfCacheMisses() const
+{
+	return _cacheMisses;
+}
+
+template <typename Derived, typename T, std::size_t N>
+unsigned long long StaticGeneticAlgorithm<Derived, T, N>::getNumberOfEvaluations() const
+{
+	return _evaluations;
+}
+
+/*----------------------------------------*/
+/* Functions the user may want to rewrite */
+/*----------------------------------------*/
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::scoreBatch(ChromosomeType const * chromosomes, Score * scores, unsigned count) const
+{
+	for (unsigned i=0 ; i<count ; i++)
+		scores[i] = derived().score(chromosomes[i]);
+}
+
+template <typename Derived, typename T, std::size_t N>
+std::uint64_t StaticGeneticAlgorithm<Derived, T, N>::chromosomeHash(ChromosomeType const & chromosome) const
+{
+	return hashChromosome(chromosome);
+}
+
+/*----------------*/
+/* Core functions */
+/*----------------*/
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::evolve()
+{
+	//While ending criterion not reached and user stop command not sent, do classic genetic algorithms stuff
+	while (_run)
+	{
+		/* 1. Verify we're not good enough */
+		
+		if (evaluateGeneration())
+			break;
+		
+		/* 2. Make it evolve */
+		
+		#ifndef DISABLE_NONBLOCKING_MODE
+		if (_steadyState)
+		{
+			//No more generations from here
+			evolveSteadyState();
+			break;
+		}
+		#endif
+		
+		nextGeneration();
+	}
+	
+	finish();
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::evaluateGeneration()
+{
+	//Compute fitness of the modified chromosomes (the previous generation stays available to best() meanwhile)
+	const unsigned unscored = evaluatePopulation(_offspring, _offspringScores, _offspringModified, _offspringScored);
+	
+	//Publish the new generation (surrounded by the mutex in case we're trying to get the best individual at the same time)
+	#ifndef DISABLE_NONBLOCKING_MODE
+	_mutex.lock();
+	#endif
+	
+	//The chromosomes left without a score by the budgets are never published
+	if (unscored > 0)
+	{
+		keepScoredChildren();
+	}
+	else
+	{
+		_population.swap(_offspring);
+		_scores.swap(_offspringScores);
+	}
+	rankPopulation();
+	
+	#ifndef DISABLE_NONBLOCKING_MODE
+	_mutex.unlock();
+	#endif
+	
+	if (_ranking.empty())
+	{
+		LOG("The budgets are exhausted before any chromosome could be evaluated.");
+		return true;
+	}
+	
+	//Log results
+	LOG("Generation " << _generation << ": best fitness score is " << _scores[_ranking.back()] << " (" << derived().print(lastElement()) << ")");
+	
+	//Check ending criterion
+	if (derived().isEvolutionOver())
+	{
+		LOG("The ending criterion was matched.");
+		return true;
+	}
+	
+	//Check the budgets (they are exhausted if they stopped the evaluation)
+	if (unscored > 0 || budgetsExhausted(_generation + 1))
+	{
+		LOG("The budgets are exhausted.");
+		return true;
+	}
+	
+	return false;
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::keepScoredChildren()
+{
+	//Scores are ranked like in rankPopulation(): NaN is the worst
+	auto better = [](Score a, Score b)
+	{
+		return a > b || (std::isnan(b) && !std::isnan(a));
+	};
+	
+	//The children evaluated in this generation, best first (the other ones are copies of chromosomes of the last generation)
+	_scoredChildren.clear();
+	for (unsigned i=0 ; i<_offspring.size() ; i++)
+	{
+		if (_offspringModified[i] && _offspringScored[i])
+			_scoredChildren.push_back(i);
+	}
+	
+	std::vector<Score> const & scores = _offspringScores;
+	std::sort(_scoredChildren.begin(), _scoredChildren.end(), [&scores, &better](unsigned a, unsigned b)
+	{
+		return better(scores[a], scores[b]) || (!better(scores[b], scores[a]) && a < b);
+	});
+	
+	//No generation evaluated yet: the first one is only made of the scored children
+	if (_ranking.empty())
+	{
+		_population.resize(_scoredChildren.size());
+		_scores.resize(_scoredChildren.size());
+		for (unsigned k=0 ; k<_scoredChildren.size() ; k++)
+		{
+			std::swap(_population[k], _offspring[_scoredChildren[k]]);
+			_scores[k] = _offspringScores[_scoredChildren[k]];
+		}
+		return;
+	}
+	
+	//The best children replace the worst chromosomes as long as they are better, which keeps the best ones of both
+	for (unsigned k=0 ; k<_scoredChildren.size() && k<_ranking.size() ; k++)
+	{
+		const unsigned child = _scoredChildren[k];
+		const unsigned index = _ranking[k];
+		if (!better(_offspringScores[child], _scores[index]))
+			break;
+		
+		std::swap(_population[index], _offspring[child]);
+		_scores[index] = _offspringScores[child];
+	}
+}
 
-/*-----------------------*/
-/* Constructor and stuff */
-/*-----------------------*/
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::nextGeneration()
+{
+	breed();
+	
+	//We've evolved!
+	_generation++;
+}
 
-template <typename T>
-GeneticAlgorithm<T>::GeneticAlgorithm()
- : _logStream(std::cout)
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::finish()
 {
-	//Default parameters
-	_populationSize = 100;
-	_mutationProbability = 0.01;
-	_endCriterion = EndingCriterion::BestScore;
-	_selectionType = SelectionType::Tournament;
-	_tournamentSize = 10;
+	if (!_ranking.empty())
+		LOG("The algorithm is over. The best individual has a fitness score of " << _scores[_ranking.back()] << " (" << derived().print(lastElement()) << ").");
 	_run = false;
-	_minChromosomeSize = 1;
-	_maxChromosomeSize = 100;
-	
-	//Other
 	_logEnable = false;
 }
 
-/*-----------------------------*/
-/* Main functions for the user */
-/*-----------------------------*/
+#ifndef DISABLE_NONBLOCKING_MODE
 
-template <typename T>
-void GeneticAlgorithm<T>::run(bool blocking, bool enableLogging, std::ostream & outputStream)
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::evolveSteadyState()
 {
-	//Logging
-	_logEnable = enableLogging;
-	_logStream = std::ref(outputStream);
+	//The evaluated population becomes the one the threads breed in, each chromosome with its own mutex (none if the budgets left it empty)
+	const unsigned size = _population.size();
+	if (size == 0)
+		return;
 	
-	//Safety check
-	if (_selectionType == SelectionType::Tournament && _tournamentSize > _populationSize)
+	_offspring.resize(size);
+	_slotMutexes.reset(new std::mutex[size]);
+	_slotScores.reset(new std::atomic<Score>[size]);
+	for (unsigned i=0 ; i<size ; i++)
 	{
-		throw std::runtime_error("The tournament size cannot be greater than the population size");
+		_offspring[i] = _population[i];
+		_slotScores[i] = _scores[i];
 	}
+	_births = 0;
 	
-	//Reset stuff
-	_lastScores.clear();
-	_run = true;
-	_generation = 0;
+	//The ranking goes from the worst chromosome to the best: dealt in this order, each shard is already a heap with its worst one on top
+	//A few shards per thread, so that the threads replacing the worst chromosomes rarely wait for the same one
+	if (_replacementType == ReplacementType::Worst)
+	{
+		_numberOfWorstShards = std::max(1u, std::min(size, 4*(unsigned)_threadPool->size()));
+		_worstShards.reset(new WorstShard[_numberOfWorstShards]);
+		for (unsigned i=0 ; i<size ; i++)
+			_worstShards[i % _numberOfWorstShards].heap.push_back(_ranking[i]);
+		for (unsigned s=0 ; s<_numberOfWorstShards ; s++)
+			_worstShards[s].top = _slotScores[_worstShards[s].heap[0]].load();
+	}
 	
-	//Create population
-	Population<T> population;
-	population.reserve(_populationSize);
+	//Every thread of the pool breeds until the end
+	_threadPool->run(_threadPool->size(), [this](unsigned, unsigned)
+	{
+		breedSteadyState();
+	});
 	
-	for (unsigned i=0 ; i<_populationSize ; i++)
+	//Make the last children available to best()
+	publishSteadyState(false);
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::breedSteadyState()
+{
+	//Buffers of this thread (the replaced chromosomes end up in there, so their memory is reused)
+	ChromosomeType parents[2];
+	ChromosomeType children[2];
+	Score parentScores[2];
+	RandomStream & random = randomStream();
+	
+	//Scores are ranked like in rankPopulation(): NaN is the worst
+	auto worse = [](Score a, Score b)
 	{
-		population.push_back(randomChromosome());
-	}
+		return a < b || (std::isnan(a) && !std::isnan(b));
+	};
 	
-	if (blocking)
+	try
 	{
-		//Just run evolve
-		evolve(population);
+		while (_run)
+		{
+			//The random numbers of each pair of children come from their own streams
+			const unsigned long long pair = _births.fetch_add(2) / 2;
+			const unsigned low = (unsigned)pair;
+			const unsigned high = (unsigned)(pair >> 32);
+			
+			/* 1. Selection: copy the winners of two tournaments */
+			
+			useRandomStream(low, 2*high, GeneticOperator::Selection);
+			for (unsigned k=0 ; k<2 ; k++)
+			{
+				const unsigned index = steadyStateTournament(random, _tournamentSize, true);
+				std::lock_guard<std::mutex> lock(_slotMutexes[index]);
+				parents[k] = _offspring[index];
+				parentScores[k] = _slotScores[index];
+			}
+			
+			/* 2. Recombination */
+			
+			useRandomStream(low, 2*high, GeneticOperator::Recombination);
+			const bool crossed = derived().cross(parents[0], parents[1], children[0], children[1]);
+			
+			for (unsigned k=0 ; k<2 ; k++)
+			{
+				/* 3. Mutation and evaluation (an unchanged child keeps the score of its parent) */
+				
+				useRandomStream(low, 2*high+k, GeneticOperator::Mutation);
+				const bool mutated = derived().mutate(children[k]);
+				
+				//A child which can't be evaluated because of the budgets ends the algorithm
+				Score childScore = parentScores[k];
+				if ((crossed || mutated) && scoreWithinBudgets(&children[k], &childScore, 1) == 0)
+				{
+					_run = false;
+					break;
+				}
+				
+				/* 4. Replacement: the child takes the place of a worse chromosome */
+				
+				if (_replacementType == ReplacementType::Tournament)
+				{
+					useRandomStream(low, 2*high+k, GeneticOperator::Replacement);
+					const unsigned index = steadyStateTournament(random, _tournamentSize, false);
+					
+					//Another thread may have replaced it meanwhile, hence the check under the lock
+					std::lock_guard<std::mutex> lock(_slotMutexes[index]);
+					if (!worse(childScore, _slotScores[index]))
+					{
+						std::swap(children[k], _offspring[index]);
+						_slotScores[index] = childScore;
+					}
+				}
+				else
+				{
+					//The worst chromosome is the worst top of the shards, which only this replacement changes (in O(log n))
+					//The tops are read without locking: a child worse than all of them is dropped without waiting for any thread
+					while (true)
+					{
+						unsigned worst = 0;
+						for (unsigned s=1 ; s<_numberOfWorstShards ; s++)
+							if (worse(_worstShards[s].top, _worstShards[worst].top))
+								worst = s;
+						
+						WorstShard & shard = _worstShards[worst];
+						if (worse(childScore, shard.top))
+							break;
+						
+						//Another thread may have replaced the top of the shard meanwhile, then look for the worst one again
+						std::lock_guard<std::mutex> heapLock(shard.mutex);
+						const unsigned index = shard.heap[0];
+						std::lock_guard<std::mutex> lock(_slotMutexes[index]);
+						if (worse(childScore, _slotScores[index]))
+							continue;
+						
+						std::swap(children[k], _offspring[index]);
+						_slotScores[index] = childScore;
+						siftWorstHeap(shard.heap);
+						shard.top = _slotScores[shard.heap[0]].load();
+						break;
+					}
+				}
+			}
+			
+			//The thread completing a "generation" publishes it and checks the ending criterion
+			const unsigned long long born = 2*(pair+1);
+			if (born / _populationSize != (born-2) / _populationSize && publishSteadyState(true))
+				_run = false;
+		}
 	}
-	else
+	catch (...)
 	{
-		#ifdef DISABLE_NONBLOCKING_MODE
-		
-		throw std::runtime_error("Cannot run in nonblocking mode because it is disabled");
-		
-		#else
-		
-		//Make the population evolve in a new thread
-		std::thread evolution(&GeneticAlgorithm<T>::evolve, this, population);
-		
-		//Detach the thread from its parent thread
-		evolution.detach();
-		
-		#endif
+		//Stop the other threads, the pool forwards the exception
+		_run = false;
+		throw;
 	}
 }
 
-template <typename T>
-void GeneticAlgorithm<T>::stop()
+template <typename Derived, typename T, std::size_t N>
+unsigned StaticGeneticAlgorithm<Derived, T, N>::steadyStateTournament(RandomStream & random, unsigned size, bool best) const
 {
-	LOG("User stopped the algorithm");
-	_run = false;
-	_logEnable = false;
+	//The indices are drawn 64 at a time
+	size = std::max(size, 1u);
+	std::uint32_t indices[64];
+	unsigned chosenIndex = 0;
+	Score chosenScore = 0;
+	
+	for (unsigned i=0 ; i<size ; i++)
+	{
+		if (i % 64 == 0)
+			random.below(_offspring.size(), indices, std::min(size - i, 64u));
+		
+		const unsigned index = indices[i % 64];
+		const Score score = _slotScores[index];
+		
+		//Keep the best one, or the worst one (NaN is the worst, like in rankPopulation())
+		const bool better = score > chosenScore || (std::isnan(chosenScore) && !std::isnan(score));
+		const bool worse = score < chosenScore || (std::isnan(score) && !std::isnan(chosenScore));
+		if (i == 0 || (best ? better : worse))
+		{
+			chosenIndex = index;
+			chosenScore = score;
+		}
+	}
+	
+	return chosenIndex;
 }
 
-template <typename T>
-Chromosome<T> GeneticAlgorithm<T>::best()
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::siftWorstHeap(std::vector<unsigned> & heap)
 {
-	//This function could likely be called from another thread so let's be thread-safe
+	//Scores are ranked like in rankPopulation(): NaN is the worst
+	auto worse = [](Score a, Score b)
+	{
+		return a < b || (std::isnan(a) && !std::isnan(b));
+	};
 	
-	#ifndef DISABLE_NONBLOCKING_MODE
-	_mutex.lock();
-	#endif
+	const unsigned size = heap.size();
+	const unsigned index = heap[0];
+	const Score score = _slotScores[index];
 	
-	Chromosome<T> best = _population.size() == 0 ? Chromosome<T>(0) : lastElement().second;
+	//Move the worse of the two children up until the chromosome isn't worse than them
+	unsigned position = 0;
+	while (2*position + 1 < size)
+	{
+		unsigned child = 2*position + 1;
+		if (child + 1 < size && worse(_slotScores[heap[child+1]], _slotScores[heap[child]]))
+			child++;
 		
-	#ifndef DISABLE_NONBLOCKING_MODE
-	_mutex.unlock();
-	#endif
-	
-	return best;
+		if (!worse(_slotScores[heap[child]], score))
+			break;
+		
+		heap[position] = heap[child];
+		position = child;
+	}
+	heap[position] = index;
 }
 
-template <typename T>
-void GeneticAlgorithm<T>::setEndingCriterion(EndingCriterion type, Score maxScoreForMaxScoreCriterion, unsigned numberOfGenerationsWithoutImprovementForBestScoreCriterion)
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::publishSteadyState(bool endOfGeneration)
 {
-	if (type == EndingCriterion::MaxScore)
+	std::lock_guard<std::mutex> lock(_mutex);
+	
+	//Copy the chromosomes one at a time, the other threads keep breeding meanwhile
+	for (unsigned i=0 ; i<_offspring.size() ; i++)
 	{
-		_maxEndScore = maxScoreForMaxScoreCriterion;
+		std::lock_guard<std::mutex> slotLock(_slotMutexes[i]);
+		_population[i] = _offspring[i];
+		_scores[i] = _slotScores[i];
 	}
-	else if (type == EndingCriterion::BestScore)
+	rankPopulation();
+	
+	if (!endOfGeneration)
+		return false;
+	
+	_generation++;
+	
+	//Log results
+	LOG("Generation " << _generation << ": best fitness score is " << _scores[_ranking.back()] << " (" << derived().print(lastElement()) << ")");
+	
+	//Check ending criterion
+	if (derived().isEvolutionOver())
 	{
-		_steadyGenerations = numberOfGenerationsWithoutImprovementForBestScoreCriterion;
+		LOG("The ending criterion was matched.");
+		return true;
 	}
 	
-	_endCriterion = type;
-}	
-
-template <typename T>
-void GeneticAlgorithm<T>::setSelectionType(SelectionType type, unsigned numberOfChromosomesForTournament)
-{
-	if (type == SelectionType::Tournament)
+	//Check the budgets
+	if (budgetsExhausted(_generation + 1))
 	{
-		_tournamentSize = numberOfChromosomesForTournament;
+		LOG("The budgets are exhausted.");
+		return true;
 	}
 	
-	_selectionType = type;
+	return false;
 }
 
-template <typename T>
-void GeneticAlgorithm<T>::setMainParameters(unsigned populationSize, double mutationProbability)
+#endif
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::breed()
 {
-	_populationSize = populationSize;
-	_mutationProbability = mutationProbability;
+	//The new population is written over the chromosomes of the previous one, so their memory is reused
+	_offspring.resize(_populationSize);
+	_offspringScores.resize(_populationSize);
+	_offspringModified.resize(_populationSize);
+	
+	//Elitism: the best chromosomes go through unchanged (so the best score never gets worse)
+	const unsigned elites = std::min<unsigned>(_elitism, std::min<unsigned>(_populationSize, _ranking.size()));
+	for (unsigned i=0 ; i<elites ; i++)
+	{
+		const unsigned index = _ranking[_ranking.size()-1-i];
+		_offspring[i] = _population[index];
+		_offspringScores[i] = _scores[index];
+		_offspringModified[i] = false;
+	}
+	
+	//Fill the new population until it has reached the wanted size
+	//Each operation draws from its own random stream, so the results only depend on the seed
+	unsigned size = elites;
+	unsigned round = 0;
+	while (size < _populationSize)
+	{
+		//A] Selection
+		useRandomStream(_generation, round++, GeneticOperator::Selection);
+		_selection.clear();
+		while (_selection.size() < 2)
+		{
+			derived().select(_selection);
+		}
+		
+		//B] Recombination: the parents are read in place and the children directly written in the new population (if they are identical to their parents, they keep their scores)
+		for (unsigned i=0 ; i<_selection.size()/2 && size<_populationSize ; i++) //If the selection size is not even, ignore the last individual
+		{
+			const unsigned first = _selection[2*i];
+			const unsigned second = _selection[2*i+1];
+			const bool room = size+1 < _populationSize;
+			
+			useRandomStream(_generation, size, GeneticOperator::Recombination);
+			const bool changed = derived().cross(_population[first], _population[second], _offspring[size], room ? _offspring[size+1] : _spareChild);
+			
+			_offspringScores[size] = _scores[first];
+			_offspringModified[size] = changed;
+			size++;
+			
+			if (room)
+			{
+				_offspringScores[size] = _scores[second];
+				_offspringModified[size] = changed;
+				size++;
+			}
+		}
+	}
+	
+	//C] Mutation (the elites are left alone)
+	for (unsigned i=elites ; i<_populationSize ; i++)
+	{
+		useRandomStream(_generation, i, GeneticOperator::Mutation);
+		if (derived().mutate(_offspring[i]))
+			_offspringModified[i] = true;
+	}
 }
 
-template <typename T>
-void GeneticAlgorithm<T>::setChromosomesSize(unsigned min, unsigned max)
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::useRandomStream(unsigned generation, unsigned index, GeneticOperator geneticOperator) const
 {
-	_minChromosomeSize = min;
-	_maxChromosomeSize = max;
+	RandomStream & random = randomStream();
+	random.seed(_seed);
+	random.restart(generation, index, (std::uint32_t)geneticOperator);
 }
 
-/*---------------------------*/
-/* Useful stuff for the user */
-/*---------------------------*/
-
-template <typename T>
-unsigned GeneticAlgorithm<T>::getNumberOfGenerations() const
+template <typename Derived, typename T, std::size_t N>
+RandomStream & StaticGeneticAlgorithm<Derived, T, N>::randomStream()
 {
-	return _generation;
+	thread_local RandomStream stream;
+	return stream;
 }
 
-/*----------------*/
-/* Core functions */
-/*----------------*/
-
-template <typename T>
-void GeneticAlgorithm<T>::evolve(Population<T> population)
+template <typename Derived, typename T, std::size_t N>
+unsigned StaticGeneticAlgorithm<Derived, T, N>::evaluatePopulation(PopulationType & population, std::vector<Score> & scores, std::vector<bool> const & modified, std::vector<bool> & scored)
 {
-	//While ending criterion not reached and user stop command not sent, do classic genetic algorithms stuff
-	while (_run)
+	scores.resize(population.size());
+	scored.assign(population.size(), true);
+	_hashes.resize(population.size());
+	_toEvaluate.clear();
+	
+	//Find the chromosomes whose score is not known yet, taking what we can from the cache
+	for (unsigned i=0 ; i<population.size() ; i++)
 	{
-		/* 1. Verify we're not good enough */
+		if (!modified[i])
+			continue;
 		
-		//Compute fitness (surrounded by the mutex in case we're trying to get the best individual when the _population is empty for example)
-		#ifndef DISABLE_NONBLOCKING_MODE
-		_mutex.lock();
-		#endif
-		
-		_population.clear();
-		for (Chromosome<T> const & chromosome : population)
+		if (_cache.enabled())
 		{
-			_population.insert( std::pair<Score, Chromosome<T> >(score(chromosome), chromosome) );
+			_hashes[i] = derived().chromosomeHash(population[i]);
+			if (_cache.find(_hashes[i], scores[i]))
+			{
+				_cacheHits++;
+				continue;
+			}
 		}
 		
-		#ifndef DISABLE_NONBLOCKING_MODE
-		_mutex.unlock();
-		#endif
-		
-		//Log results
-		LOG("Generation " << _generation << ": best fitness score is " << lastElement().first << " (" << print(lastElement().second) << ")");
+		_toEvaluate.push_back(i);
+	}
+	
+	//Longest first only matters when the chromosomes are shared between several threads
+	#ifndef DISABLE_NONBLOCKING_MODE
+	const bool orderByCost = _parallelEvaluation && _threadPool && _threadPool->size() > 1;
+	#else
+	const bool orderByCost = false;
+	#endif
+	
+	_costs.resize(population.size());
+	bool knownCosts = false;
+	if (orderByCost)
+	{
+		for (unsigned i : _toEvaluate)
+		{
+			_costs[i] = derived().evaluationCost(population[i]);
+			knownCosts = knownCosts || _costs[i] != 0.0;
+		}
+	}
+	
+	//Usual case without cache nor costs in the first generation: no need to gather anything
+	if (_toEvaluate.size() == population.size() && !_cache.enabled() && !knownCosts)
+	{
+		const unsigned unscored = scorePopulation(population, scores);
+		if (unscored > 0)
+		{
+			for (unsigned i=0 ; i<population.size() ; i++)
+				scored[i] = _scored[i] != 0;
+		}
+		return unscored;
+	}
+	
+	//Sort the missing chromosomes by hash so that the duplicates inside the generation are next to each other
+	if (_cache.enabled())
+	{
+		std::vector<std::uint64_t> const & hashes = _hashes;
+		std::sort(_toEvaluate.begin(), _toEvaluate.end(), [&hashes](unsigned a, unsigned b)
+		{
+			return hashes[a] < hashes[b] || (hashes[a] == hashes[b] && a < b);
+		});
+	}
+	
+	//Tell if the k-th chromosome to evaluate is the same as the previous one (which can only be known with the cache)
+	auto isDuplicate = [&](unsigned k)
+	{
+		return _cache.enabled() && k > 0 && _hashes[_toEvaluate[k]] == _hashes[_toEvaluate[k-1]];
+	};
+	
+	//Keep one chromosome per hash, the most expensive ones first
+	_batchOrder.clear();
+	for (unsigned k=0 ; k<_toEvaluate.size() ; k++)
+	{
+		if (!isDuplicate(k))
+			_batchOrder.push_back(k);
+	}
+	
+	if (knownCosts)
+	{
+		std::vector<double> const & costs = _costs;
+		std::vector<unsigned> const & toEvaluate = _toEvaluate;
+		std::sort(_batchOrder.begin(), _batchOrder.end(), [&costs, &toEvaluate](unsigned a, unsigned b)
+		{
+			return costs[toEvaluate[a]] > costs[toEvaluate[b]] || (costs[toEvaluate[a]] == costs[toEvaluate[b]] && a < b);
+		});
+	}
+	
+	//Gather them (swapping them is cheap and keeps their memory), evaluate them and put them back
+	_batch.resize(_batchOrder.size());
+	for (unsigned b=0 ; b<_batchOrder.size() ; b++)
+		std::swap(_batch[b], population[_toEvaluate[_batchOrder[b]]]);
+	
+	scorePopulation(_batch, _batchScores);
+	
+	//If the budgets stopped the evaluation, some chromosomes have no score: they don't go into the cache
+	unsigned unscored = 0;
+	for (unsigned b=0 ; b<_batchOrder.size() ; b++)
+	{
+		const unsigned index = _toEvaluate[_batchOrder[b]];
+		std::swap(_batch[b], population[index]);
+		scores[index] = _batchScores[b];
+		scored[index] = _scored[b] != 0;
 		
-		//Check ending criterion
-		if (isEvolutionOver())
+		if (!scored[index])
 		{
-			LOG("The ending criterion was matched.");
-			break;
+			unscored++;
+			continue;
 		}
 		
-		/* 2. Make it evolve */
+		if (_cache.enabled())
+		{
+			_cache.insert(_hashes[index], scores[index]);
+			_cacheMisses++;
+		}
+	}
+	
+	//The duplicates take the score of the previous chromosome, which is known now (or not)
+	for (unsigned k=0 ; k<_toEvaluate.size() ; k++)
+	{
+		if (isDuplicate(k))
+		{
+			const unsigned index = _toEvaluate[k];
+			scores[index] = scores[_toEvaluate[k-1]];
+			scored[index] = scored[_toEvaluate[k-1]];
+			if (scored[index])
+				_cacheHits++;
+			else
+				unscored++;
+		}
+	}
+	
+	return unscored;
+}
+
+template <typename Derived, typename T, std::size_t N>
+unsigned StaticGeneticAlgorithm<Derived, T, N>::scorePopulation(PopulationType const & population, std::vector<Score> & scores)
+{
+	scores.resize(population.size());
+	_scored.resize(population.size());
+	std::atomic<unsigned> unscored(0);
+	
+	//Score a range of the population in one batch (scoreBatch() is const so every worker can call it at the same time)
+	auto evaluateRange = [&](unsigned begin, unsigned end)
+	{
+		if (begin >= end)
+			return;
 		
-		//Prepare new population
-		population.clear();
-		population.reserve(_populationSize);
+		const unsigned count = scoreWithinBudgets(population.data() + begin, scores.data() + begin, end - begin);
+		std::fill(_scored.begin() + begin, _scored.begin() + begin + count, 1);
+		std::fill(_scored.begin() + begin + count, _scored.begin() + end, 0);
+		if (begin + count < end)
+			unscored += end - begin - count;
+	};
+	
+	#ifndef DISABLE_NONBLOCKING_MODE
+	if (_parallelEvaluation && _threadPool)
+	{
+		//Small chunks so that the threads done early can steal from the others (about 8 per thread by default)
+		const unsigned chunkSize = _evaluationChunkSize > 0 ? _evaluationChunkSize : population.size() / (8 * _threadPool->size());
+		_threadPool->run(population.size(), evaluateRange, chunkSize);
+		return unscored;
+	}
+	#endif
+	
+	//With budgets, the population is evaluated in chunks too, so that they are checked during the generation (8 chunks by default)
+	const unsigned chunkSize = !hasEvaluationBudgets() ? population.size() : _evaluationChunkSize > 0 ? _evaluationChunkSize : std::max((unsigned)population.size() / 8, 1u);
+	for (unsigned begin=0 ; begin<population.size() ; begin+=chunkSize)
+		evaluateRange(begin, std::min(begin + chunkSize, (unsigned)population.size()));
+	return unscored;
+}
+
+template <typename Derived, typename T, std::size_t N>
+unsigned StaticGeneticAlgorithm<Derived, T, N>::scoreWithinBudgets(ChromosomeType const * chromosomes, Score * scores, unsigned count)
+{
+	//With a budget of time and the default chunks, the chromosomes are scored in batches of about a millisecond, so that the clocks are checked that often
+	//The first batch of a run holds one chromosome, each next one is sized after the speed of the one before (twice as large at most), from a chunk to the next
+	const bool timed = (_maxSeconds > 0 || _maxProcessorSeconds > 0) && _evaluationChunkSize == 0;
+	unsigned batch = timed ? _timedBatch.load() : count;
+	unsigned scored = 0;
+	while (scored < count)
+	{
+		const unsigned size = std::min(batch, count - scored);
 		
-		//Fill the new population until it has reached the wanted size
-		while (population.size() < _populationSize)
+		//The generations are only completed between two evaluations, so they are not counted here
+		//The first batch of a run is always scored, so that best() has a chromosome to give even when the budgets of time are over before it
+		unsigned allowed = size;
+		if (hasEvaluationBudgets())
 		{
-			//A] Selection
-			Population<T> selection;
-			while (selection.size() < 2)
+			if (budgetsExhausted(0) && _evaluations > 0)
 			{
-				Population<T> tmp = select();
-				selection.insert(selection.end(), tmp.begin(), tmp.end());
+				allowed = 0;
 			}
-			
-			//B] Recombination
-			for (unsigned i=0 ; i<selection.size()/2 ; i++) //If the selection size is not even, ignore the last individual
+			else if (_maxEvaluations > 0 && _budgetCombination == BudgetCombination::Any)
+			{
+				//The evaluations are reserved before being done so that the threads together never exceed the budget
+				const unsigned long long before = _evaluations.fetch_add(size);
+				allowed = before >= _maxEvaluations ? 0 : (unsigned)std::min<unsigned long long>(size, _maxEvaluations - before);
+				_evaluations -= size - allowed;
+			}
+			else
 			{
-				Population<T> newChromosomes = cross({selection[2*i], selection[2*i+1]});
-				population.push_back(newChromosomes.front());
-				population.push_back(newChromosomes.back());
+				_evaluations += size;
 			}
 		}
+		else
+		{
+			_evaluations += size;
+		}
+		
+		const std::chrono::steady_clock::time_point start = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+		if (allowed > 0)
+			derived().scoreBatch(chromosomes + scored, scores + scored, allowed);
 		
-		//C] Mutation
-		for (Chromosome<T> & chromosome : population)
+		//The target score is noticed as soon as a chromosome reaches it
+		if (!std::isnan(_targetScore))
 		{
-			mutate(chromosome);
+			for (unsigned i=scored ; i<scored+allowed ; i++)
+				if (scores[i] >= _targetScore)
+					_targetReached = true;
 		}
 		
-		//We've evolved!
-		_generation++;
+		scored += allowed;
+		if (allowed < size)
+			break;
+		
+		if (timed)
+		{
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			const double fitting = elapsed > 0.0 ? batch * 0.001 / elapsed : 2.0 * batch;
+			batch = (unsigned)std::max(1.0, std::min(2.0 * batch, fitting));
+			_timedBatch = batch;
+		}
 	}
 	
-	LOG("The algorithm is over. The best individual has a fitness score of " << lastElement().first << " (" << print(lastElement().second) << ").");
-	_run = false;
-	_logEnable = false;
+	std::fill(scores + scored, scores + count, std::numeric_limits<Score>::quiet_NaN());
+	return scored;
 }
 
-template <typename T>
-bool GeneticAlgorithm<T>::isEvolutionOver()
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::budgetsExhausted(unsigned completedGenerations) const
+{
+	//The state of each budget which is set
+	bool exhausted[5];
+	unsigned count = 0;
+	
+	if (_maxSeconds > 0)
+		exhausted[count++] = std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count() >= _maxSeconds;
+	if (_maxProcessorSeconds > 0)
+		exhausted[count++] = (double)(std::clock() - _startClock) / CLOCKS_PER_SEC >= _maxProcessorSeconds;
+	if (_maxEvaluations > 0)
+		exhausted[count++] = _evaluations >= _maxEvaluations;
+	if (_maxGenerations > 0)
+		exhausted[count++] = completedGenerations >= _maxGenerations;
+	if (!std::isnan(_targetScore))
+		exhausted[count++] = _targetReached;
+	
+	if (count == 0)
+		return false;
+	if (_budgetCombination == BudgetCombination::Any)
+		return std::find(exhausted, exhausted + count, true) != exhausted + count;
+	return std::find(exhausted, exhausted + count, false) == exhausted + count;
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::hasEvaluationBudgets() const
+{
+	return _maxSeconds > 0 || _maxProcessorSeconds > 0 || _maxEvaluations > 0 || !std::isnan(_targetScore);
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::isEvolutionOver()
 {
 	if (_endCriterion == EndingCriterion::MaxScore)
 	{
 		//Just check if the best chromosome has a score high enough
-		return lastElement().first >= _maxEndScore;
+		return _scores[_ranking.back()] >= _maxEndScore;
 	}
 	else if (_endCriterion == EndingCriterion::BestScore)
 	{	
-		//Append the score of the best chromosome to the buffer
-		_lastScores.push_back(lastElement().first);
+		//Compare the score of the best chromosome with the best score so far (a number replaces a NaN record)
+		const Score best = _scores[_ranking.back()];
+		const Score threshold = std::max(_absoluteImprovement, _relativeImprovement * std::abs(_recordScore));
+		const bool better = _stagnation == ~0u || best > _recordScore + threshold || (std::isnan(_recordScore) && !std::isnan(best));
 		
-		//If we don't have enough generations, exit, otherwise, remove the oldest best score
-		if (_lastScores.size() <= 10)
+		//Count the generations since the last improvement
+		if (better)
 		{
-			return false;
+			_recordScore = best;
+			_stagnation = 0;
 		}
 		else
 		{
-			_lastScores.pop_front();
-		}
-		
-		//Run through the buffer to see if the best score has gotten any better during the last generations
-		bool better = false;
-		Score first = _lastScores.front();
-		for (Score s : _lastScores)
-		{
-			if (s > first)
-			{
-				better = true;
-				break;
-			}
+			_stagnation++;
 		}
 		
-		//If yes, continue, otherwise, we have reached the end of the evolution
-		return !better;
+		//If they are too many, we have reached the end of the evolution
+		return _stagnation >= _steadyGenerations;
 	}
 	else if (_endCriterion == EndingCriterion::NeverStop)
 	{
@@ -524,64 +3807,81 @@ bool GeneticAlgorithm<T>::isEvolutionOver()
 	}
 }
 
-template <typename T>
-Population<T> GeneticAlgorithm<T>::select() const
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::select(std::vector<unsigned> & selection) const
 {
+	RandomStream & random = randomStream();
+	
 	if (_selectionType == SelectionType::RouletteWheel)
 	{
 		/* The roulette wheel selection (also known asp FPS: fitness proportionate selection) works by randomly choosing a chromosome inside the population. However, the probability is measured as a fitness score. Hence, the highest score a chromosome has, the best chance it will have to be selected. */
 		
+		//Without any positive score, every chromosome gets the same slot
+		if (totalScore() <= 0.0)
+		{
+			selection.push_back(random.below(_population.size()));
+			return;
+		}
+		
 		//Generate a random number between 0 and total fitness of the population (make the wheel spin)
-		const double probability = Random::get(0.0, totalScore());
+		const double probability = random.uniform(0.0, totalScore());
 		
-		//Return the corresponding chromosome (say where it stopped)
-		return { chromosome(probability) };
+		//Select the corresponding chromosome (say where it stopped)
+		selection.push_back(individual(probability));
 	}
 	else if (_selectionType == SelectionType::StochasticUniversal)
 	{
 		/* In stochastic universal sampling (SUS), we choose a random number of chromosomes to be selected. The thing is, these chromosomes will have their fitness scores evenly spaced inside the fitness distribution. */
 		
 		//Choose a number of chromosomes to select
-		unsigned toSelect = Random::get(1, _population.size()/10);
-		Score distanceBetweenScores = totalScore() / (Score)toSelect;
+		unsigned toSelect = random.uniform(1u, _population.size()/10);
+		const Score total = totalScore();
+		
+		//Without any positive score, the chromosomes are evenly spaced on the population itself
+		if (total <= 0.0)
+		{
+			const unsigned first = random.below(_population.size());
+			for (unsigned i=0 ; i<toSelect ; i++)
+				selection.push_back((first + (std::uint64_t)i * _population.size() / toSelect) % _population.size());
+			return;
+		}
+		
+		Score distanceBetweenScores = total / (Score)toSelect;
 		
 		//Generate the first score whose chromosome will be selected
-		Score firstScore = Random::get(0.0, distanceBetweenScores);
+		Score firstScore = random.uniform(0.0, distanceBetweenScores);
 		
 		//Select chromosomes at equidistant fitness scores starting at firstScore
-		Population<T> selected;
-		for (Score score = firstScore ; score <= totalScore() ; score += distanceBetweenScores)
+		for (Score score = firstScore ; score <= total ; score += distanceBetweenScores)
 		{
-			selected.push_back(chromosome(score));
+			selection.push_back(individual(score));
 		}
-		return selected;
 	}
 	else if (_selectionType == SelectionType::Tournament)
 	{
 		/* In tournament selection, we randomly pick a fixed number of chromosomes and keep the best among them. The size of the tournament is defined by the user.  */
 		
-		//Populate the tournament (we use indices only)
-		std::vector<unsigned> tournament;
-		for (unsigned i=0 ; i<_tournamentSize ; i++)
-		{
-			tournament.push_back(Random::get(0, _population.size()-1));
-		}
+		//Pick the chromosomes of the tournament (drawn 64 at a time) and keep the best, the first one winning ties (we use indices only)
+		const unsigned size = std::max(_tournamentSize, 1u);
+		std::uint32_t indices[64];
+		unsigned bestIndex = 0;
+		Score bestScore = 0;
 		
-		//Find the best chromosome
-		unsigned bestIndex = tournament[0];
-		Score bestScore = score(bestIndex);
-		
-		for (unsigned i=0 ; i<_tournamentSize ; i++)
+		for (unsigned i=0 ; i<size ; i++)
 		{
-			if (score(tournament[i]) > bestScore)
+			if (i % 64 == 0)
+				random.below(_population.size(), indices, std::min(size - i, 64u));
+			
+			const unsigned index = indices[i % 64];
+			if (i == 0 || score(index) > bestScore)
 			{
-				bestIndex = tournament[i];
+				bestIndex = index;
 				bestScore = score(bestIndex);
 			}
 		}
 		
-		//Return the best chromosome
-		return { chromosome(bestIndex) };
+		//Select the best chromosome
+		selection.push_back(_ranking[bestIndex]);
 	}
 	else
 	{
@@ -589,13 +3889,29 @@ Population<T> GeneticAlgorithm<T>::select() const
 	}
 }
 
-template <typename T>
-Population<T> GeneticAlgorithm<T>::cross(Population<T> const & chromosomes) const
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::cross(ChromosomeType const & first, ChromosomeType const & second, ChromosomeType & firstChild, ChromosomeType & secondChild) const
 {
-	/* NB: this function was written for recombination between 2 chromosomes only but can easily be rewritten for more (without changing its prototype). */
+	RandomStream & random = randomStream();
+	
+	//Start from copies of the parents
+	firstChild = first;
+	secondChild = second;
 	
 	//Get the size of the smallest chromosome
-	unsigned sizeOfSmallest = std::min(chromosomes[0].size(), chromosomes[1].size());
+	unsigned sizeOfSmallest = std::min(first.size(), second.size());
+	
+	//The operators of the library recombine the children in place
+	if (_crossoverType == CrossoverType::OnePoint)
+		return onePointCrossover(firstChild, secondChild, sizeOfSmallest, random);
+	else if (_crossoverType == CrossoverType::TwoPoint)
+		return twoPointCrossover(firstChild, secondChild, sizeOfSmallest, random);
+	else if (_crossoverType == CrossoverType::Uniform)
+		return uniformCrossover(firstChild, secondChild, sizeOfSmallest, random);
+	else if (_crossoverType == CrossoverType::Blend || _crossoverType == CrossoverType::SimulatedBinary)
+		return mixGenes(firstChild, secondChild, sizeOfSmallest, random, std::is_floating_point<T>());
+	else if (_crossoverType == CrossoverType::PartiallyMapped || _crossoverType == CrossoverType::Ordered || _crossoverType == CrossoverType::Cycle)
+		return crossPermutations(first, second, firstChild, secondChild, sizeOfSmallest, random, std::is_integral<T>());
 
 
 	/* TEST */
@@ -612,21 +3928,21 @@ Population<T> GeneticAlgorithm<T>::cross(Population<T> const & chromosomes) cons
 	
 	/*------*/
 
-	//Select genes to exchange
-	std::vector<unsigned> genesToExchange; 
+	//Exchange segments of genes
+	bool changed = false;
 	unsigned index = 0;
 	bool add = true;
 	while(index < sizeOfSmallest)
 	{
 		//Generate a final gene index
-		unsigned next = Random::get(index, sizeOfSmallest);
+		unsigned next = random.uniform(index, sizeOfSmallest);
 		
-		//Add all the indices in-between, half the time
+		//Exchange all the genes in-between, half the time (only the different ones actually change the chromosomes)
 		//We will get something like: {0 -> 2}, {5 -> 9}, etc...
 		if (add)
 		{
-			for (unsigned i=index ; i<next ; i++)
-				genesToExchange.push_back(i);
+			if (swapGenes(firstChild, secondChild, index, next))
+				changed = true;
 			add = false;
 		}
 		else
@@ -635,114 +3951,649 @@ Population<T> GeneticAlgorithm<T>::cross(Population<T> const & chromosomes) cons
 		index = next;
 	}
 	
-	//Exchange the genes
-	Population<T> result = chromosomes;
-	for (unsigned i=0 ; i<genesToExchange.size() ; i++)
-	{
-		unsigned index = genesToExchange[i];
-		Chromosome<T> tmp = result[0];
-		result[0][index] = result[1][index];
-		result[1][index] = tmp[index];
-	}
-	
-	return result;
+	return changed;
 }
 
-template <typename T>
-void GeneticAlgorithm<T>::mutate(Chromosome<T> & chromosome) const
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::mutate(ChromosomeType & chromosome) const
 {
+	RandomStream & random = randomStream();
+	
+	//Each gene has its own chance
+	if (_mutationType == MutationType::PerGene)
+		return mutateGenes(chromosome, random, std::is_same<T, Bit>());
+	
+	bool changed = false;
+	
 	//Activate mutation only if we have a number low enough
-	if (Random::get(0.0, 1.0) <= _mutationProbability)
+	if (random.unit() <= _mutationProbability && !chromosome.empty())
 	{
+		//Move genes around
+		if (_mutationType == MutationType::Swap)
+			return swapMutation(chromosome, random);
+		else if (_mutationType == MutationType::Insertion)
+			return insertionMutation(chromosome, random);
+		else if (_mutationType == MutationType::Inversion)
+			return inversionMutation(chromosome, random);
+		
+		//Add noise to all the genes
+		if (_mutationType == MutationType::Gaussian)
+			return perturbGenes(chromosome, random, std::is_floating_point<T>());
+		
 		//Choose genes from begin to end-1
-		const unsigned begin = Random::get(0, chromosome.size()-1);
-		const unsigned end = Random::get(begin, chromosome.size());
+		const unsigned begin = random.below(chromosome.size());
+		const unsigned end = random.uniform(begin, chromosome.size());
 		
 		//Replace them with random values
-		for (unsigned i=begin ; i<end ; i++)
-			chromosome[i] = randomGene();
+		changed = replaceGenes(chromosome, begin, end, random, std::is_same<T, Bit>());
+	}
+	
+	return changed;
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::replaceGenes(ChromosomeType & chromosome, unsigned begin, unsigned end, RandomStream & random, std::false_type) const
+{
+	//SGA::Random is restarted from our stream so that randomGene() is reproducible too (until the end of the function)
+	RandomSeed seed(random());
+	
+	bool changed = false;
+	for (unsigned i=begin ; i<end ; i++)
+	{
+		const T gene = derived().randomGene();
+		if (!GeneComparison<T>::equal(chromosome[i], gene))
+		{
+			chromosome[i] = gene;
+			changed = true;
+		}
 	}
+	
+	return changed;
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::replaceGenes(ChromosomeType & chromosome, unsigned begin, unsigned end, RandomStream & random, std::true_type) const
+{
+	//Bits are replaced by whole words
+	return randomizeBits(chromosome, begin, end, random);
 }	
 
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::mutateGenes(ChromosomeType & chromosome, RandomStream & random, std::false_type) const
+{
+	if (_mutationProbability <= 0.0)
+		return false;
+	
+	//SGA::Random is restarted from our stream so that randomGene() is reproducible too (until the end of the function)
+	RandomSeed seed(random());
+	
+	//Jump from one mutated gene to the next one (log1p stays accurate for tiny probabilities, and a probability of 1 gives -inf, hence no skip)
+	const double logOfFailure = std::log1p(-std::min(_mutationProbability, 1.0));
+	bool changed = false;
+	for (double position = geometricSkip(logOfFailure, random) ; position < chromosome.size() ; position += 1.0 + geometricSkip(logOfFailure, random))
+	{
+		const unsigned i = static_cast<unsigned>(position);
+		const T gene = derived().randomGene();
+		if (!GeneComparison<T>::equal(chromosome[i], gene))
+		{
+			chromosome[i] = gene;
+			changed = true;
+		}
+	}
+	
+	return changed;
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::mutateGenes(ChromosomeType & chromosome, RandomStream & random, std::true_type) const
+{
+	if (_mutationProbability <= 0.0)
+		return false;
+	
+	//The mutated bits are flipped
+	const double logOfFailure = std::log1p(-std::min(_mutationProbability, 1.0));
+	bool changed = false;
+	for (double position = geometricSkip(logOfFailure, random) ; position < chromosome.size() ; position += 1.0 + geometricSkip(logOfFailure, random))
+	{
+		const unsigned i = static_cast<unsigned>(position);
+		chromosome[i] = Bit(!chromosome[i]);
+		changed = true;
+	}
+	
+	return changed;
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::mixGenes(ChromosomeType & first, ChromosomeType & second, unsigned size, RandomStream & random, std::true_type) const
+{
+	if (_crossoverType == CrossoverType::Blend)
+		return blendCrossover(first, second, size, _blendAlpha, random, _minGene, _maxGene);
+	
+	return simulatedBinaryCrossover(first, second, size, _distributionIndex, random, _minGene, _maxGene);
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::mixGenes(ChromosomeType &, ChromosomeType &, unsigned, RandomStream &, std::false_type) const
+{
+	//Refused by setCrossoverType()
+	throw std::runtime_error("The Blend and SimulatedBinary crossovers need floating point genes");
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::perturbGenes(ChromosomeType & chromosome, RandomStream & random, std::true_type) const
+{
+	return gaussianMutation(chromosome, _mutationDeviation, random, _minGene, _maxGene);
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::perturbGenes(ChromosomeType &, RandomStream &, std::false_type) const
+{
+	//Refused by setMutationType()
+	throw std::runtime_error("The Gaussian mutation needs floating point genes");
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::crossPermutations(ChromosomeType const & first, ChromosomeType const & second, ChromosomeType & firstChild, ChromosomeType & secondChild, unsigned size, RandomStream & random, std::true_type) const
+{
+	if (_crossoverType == CrossoverType::PartiallyMapped)
+		return partiallyMappedCrossover(first, second, firstChild, secondChild, size, random);
+	else if (_crossoverType == CrossoverType::Ordered)
+		return orderCrossover(first, second, firstChild, secondChild, size, random);
+	
+	return cycleCrossover(first, second, firstChild, secondChild, size, random);
+}
+
+template <typename Derived, typename T, std::size_t N>
+bool StaticGeneticAlgorithm<Derived, T, N>::crossPermutations(ChromosomeType const &, ChromosomeType const &, ChromosomeType &, ChromosomeType &, unsigned, RandomStream &, std::false_type) const
+{
+	//Refused by setCrossoverType()
+	throw std::runtime_error("The PartiallyMapped, Ordered and Cycle crossovers need integer genes");
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::fillPermutation(ChromosomeType & chromosome, RandomStream & random, std::true_type) const
+{
+	randomPermutation(chromosome, chromosome.size(), random);
+}
+
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::fillPermutation(ChromosomeType &, RandomStream &, std::false_type) const
+{
+	//Refused by setPermutations()
+	throw std::runtime_error("The permutations need integer genes");
+}
+
 /*--------------------------------*/
 /* Useful stuff for the algorithm */
 /*--------------------------------*/
 
-template <typename T>
-Chromosome<T> GeneticAlgorithm<T>::randomChromosome() const
+template <typename Derived, typename T, std::size_t N>
+typename StaticGeneticAlgorithm<Derived, T, N>::ChromosomeType StaticGeneticAlgorithm<Derived, T, N>::randomChromosome() const
 {
-	const unsigned size = Random::get(_minChromosomeSize, _maxChromosomeSize);
+	RandomStream & random = randomStream();
 	
-	Chromosome<T> result(size);
+	const unsigned size = random.uniform(_minChromosomeSize, _maxChromosomeSize);
 	
-	std::generate(result.begin(), result.end(), [&](){ return this->randomGene(); }); //god bless lambda functions
+	ChromosomeType result = ChromosomeTraits<T, N>::create(size);
+	
+	if (_permutations)
+	{
+		fillPermutation(result, random, std::is_integral<T>());
+		return result;
+	}
+	
+	//SGA::Random is restarted from our stream so that randomGene() is reproducible too (until the end of the function)
+	RandomSeed seed(random());
+	
+	for (unsigned i=0 ; i<result.size() ; i++)
+		result[i] = derived().randomGene();
 	
 	return result;
 }
 
-template <typename T>
-Score GeneticAlgorithm<T>::score(unsigned index) const
+template <typename Derived, typename T, std::size_t N>
+void StaticGeneticAlgorithm<Derived, T, N>::rankPopulation()
+{
+	_ranking.resize(_population.size());
+	std::iota(_ranking.begin(), _ranking.end(), 0);
+	
+	//Sort by ascending score, equal scores keep their insertion order (NaN scores are considered the worst so the ordering stays strict)
+	std::vector<Score> const & scores = _scores;
+	std::sort(_ranking.begin(), _ranking.end(), [&scores](unsigned a, unsigned b)
+	{
+		const Score sa = scores[a];
+		const Score sb = scores[b];
+		if (sa < sb || (std::isnan(sa) && !std::isnan(sb)))
+			return true;
+		if (sb < sa || std::isnan(sb) != std::isnan(sa))
+			return false;
+		return a < b;
+	});
+	
+	//Accumulate the scores by ascending order (the fitness proportionate selections can't do anything with negative scores so they count as 0, and pick uniformly if the total is 0)
+	_cumulativeScores.resize(_ranking.size());
+	Score cumulativeFitness = 0.0;
+	for (unsigned i=0 ; i<_ranking.size() ; i++)
+	{
+		const Score score = _scores[_ranking[i]];
+		if (score > 0.0)
+			cumulativeFitness += score;
+		_cumulativeScores[i] = cumulativeFitness;
+	}
+}
+
+template <typename Derived, typename T, std::size_t N>
+Score StaticGeneticAlgorithm<Derived, T, N>::score(unsigned index) const
 {
 	//Safety check
-	if (index >= _population.size())
+	if (index >= _ranking.size())
 		return 0.0;
+	
+	return _scores[_ranking[index]];
+}
+
+template <typename Derived, typename T, std::size_t N>
+Score StaticGeneticAlgorithm<Derived, T, N>::totalScore() const
+{
+	return _cumulativeScores.empty() ? 0.0 : _cumulativeScores.back();
+}
+
+template <typename Derived, typename T, std::size_t N>
+unsigned StaticGeneticAlgorithm<Derived, T, N>::individual(Score fitness) const
+{
+	//The accumulated scores are sorted, so a binary search finds the first one exceeding the required fitness (the chromosomes counting as 0 are never picked).
+	auto it = std::upper_bound(_cumulativeScores.begin(), _cumulativeScores.end(), fitness);
+	
+	//In case we didn't find anything, just return the best element.
+	if (it == _cumulativeScores.end())
+		return _ranking.back();
+	
+	return _ranking[it - _cumulativeScores.begin()];
+}
+
+template <typename Derived, typename T, std::size_t N>
+typename StaticGeneticAlgorithm<Derived, T, N>::ChromosomeType StaticGeneticAlgorithm<Derived, T, N>::chromosome(unsigned index) const
+{
+	//Safety check
+	if (index >= _ranking.size())
+		return lastElement();
+	
+	return _population[_ranking[index]];
+}
+
+template <typename Derived, typename T, std::size_t N>
+typename StaticGeneticAlgorithm<Derived, T, N>::ChromosomeType const & StaticGeneticAlgorithm<Derived, T, N>::lastElement() const
+{
+	return _population[_ranking.back()];
+}
+
+template <typename Derived, typename T, std::size_t N>
+template <typename Send>
+void StaticGeneticAlgorithm<Derived, T, N>::emigrate(unsigned count, Send send) const
+{
+	for (unsigned i=0 ; i<count && i<_ranking.size() ; i++)
+	{
+		const unsigned index = _ranking[_ranking.size()-1-i];
+		send(_population[index], _scores[index]);
+	}
+}
+
+template <typename Derived, typename T, std::size_t N>
+template <typename Receive>
+unsigned StaticGeneticAlgorithm<Derived, T, N>::immigrate(unsigned count, Receive receive)
+{
+	#ifndef DISABLE_NONBLOCKING_MODE
+	std::lock_guard<std::mutex> lock(_mutex);
+	#endif
+	
+	//Replace the worst chromosomes first
+	unsigned received = 0;
+	while (received < count && received < _ranking.size())
+	{
+		const unsigned index = _ranking[received];
+		if (!receive(_population[index], _scores[index]))
+			break;
+		received++;
+	}
+	
+	if (received > 0)
+		rankPopulation();
+	
+	return received;
+}
+
+#ifndef DISABLE_NONBLOCKING_MODE
+
+/******************/
+/** Island model **/
+/******************/
+
+//Several populations of the same algorithm evolving in parallel (one thread per island) and exchanging their best chromosomes every few generations
+template <typename Algorithm>
+class IslandModel
+{
+	typedef typename Algorithm::GeneType T;
+	typedef typename Algorithm::ChromosomeType ChromosomeType;
+	typedef typename Algorithm::EngineType Island;
+	
+	public :
+		
+		//Constructor (the arguments after the number of islands are given to the constructor of each island)
+		template <typename... Args>
+		IslandModel(unsigned numberOfIslands, Args&&... args);
+		
+		//Destructor (stops the islands)
+		~IslandModel();
+		
+		//Set how the islands exchange their chromosomes: every interval generations, each island sends its numberOfMigrants best chromosomes to the islands given by the topology
+		void setMigration(MigrationTopology topology, unsigned interval, unsigned numberOfMigrants);
+		
+		//Seed every island (each one derives its own seed from this one)
+		void setSeed(std::uint64_t seed);
+		
+		//Run the islands until one of them reaches its ending criterion or exhausts its budgets (same parameters as GeneticAlgorithm::run)
+		//The other islands then stop at the end of their current generation, or of their first one if they haven't evaluated it yet
+		//The islands exchange their migrants between two generations, so they can't run in the steady state mode
+		void run(bool blocking = true, bool enableLogging = false, std::ostream & outputStream = std::cout);
+		
+		//Stop the islands and wait for them
+		void stop();
+		
+		//Get the best chromosome of all the islands (the islands which haven't evaluated a generation yet are ignored)
+		ChromosomeType best();
+		
+		//Get the score of the best chromosome of all the islands (same)
+		Score bestScore();
+		
+		//Get an island to set its parameters (before calling run)
+		Algorithm & island(unsigned index);
+		
+		//Get the number of islands
+		unsigned getNumberOfIslands() const;
+		
+	private :
+		
+		typedef std::pair<ChromosomeType, Score> Migrant;
 		
-	//Move an iterator to the corresponding index and return the score
-	auto it = _population.begin();
-	std::advance(it, index);
+		//Make an island evolve and exchange its chromosomes with the other ones
+		void evolve(unsigned index);
+		
+		//Send the best chromosomes of an island and receive the ones sent to it
+		void migrate(unsigned index);
+		
+		//Wait for the threads of the islands and rethrow the first error that happened in one of them
+		void join();
+		
+		//Get the index of the island with the best chromosome, among the ones which have evaluated a generation (0 if none has)
+		unsigned bestIsland();
+		
+		std::vector<std::unique_ptr<Algorithm> >					_islands;			//The populations
+		std::vector<std::unique_ptr<LockFreeQueue<Migrant> > >	_queues;			//The migrants from island i to island j are in _queues[i*numberOfIslands+j]
+		std::vector<Migrant>									_incoming;			//Buffer of each island receiving its migrants
+		std::vector<Xoshiro256>									_destinations;		//Generator of each island picking its destination (random topology)
+		std::vector<std::thread>								_threads;			//The threads in which the islands evolve
+		MigrationTopology										_topology;			//Where the migrants go
+		unsigned												_interval;			//Number of generations between two migrations
+		unsigned												_numberOfMigrants;	//Number of chromosomes sent by an island at each migration
+		std::atomic<bool>										_run;				//Boolean used to stop all the islands when one of them is over
+		std::exception_ptr										_error;				//First error thrown by an island
+		std::mutex												_mutex;				//Protects _error and the log stream from the island threads
+		
+		//Logging
+		bool 													_logEnable;			//Boolean used to know if the logging is enabled
+		std::reference_wrapper<std::ostream>					_logStream;			//Stream to which messages must be logged (std::ostream& is not copyable)
+};
+
+template <typename Algorithm>
+template <typename... Args>
+IslandModel<Algorithm>::IslandModel(unsigned numberOfIslands, Args&&... args)
+ : _topology(MigrationTopology::Ring), _interval(10), _numberOfMigrants(1), _run(false), _logEnable(false), _logStream(std::cout)
+{
+	if (numberOfIslands == 0)
+		throw std::runtime_error("The island model needs at least one island");
 	
-	return it->first;
+	for (unsigned i=0 ; i<numberOfIslands ; i++)
+		_islands.push_back(std::unique_ptr<Algorithm>(new Algorithm(args...)));
+	
+	_incoming.resize(numberOfIslands);
+	for (unsigned i=0 ; i<numberOfIslands ; i++)
+		_destinations.push_back(Xoshiro256(Random::engine()()));
 }
 
-template <typename T>
-Score GeneticAlgorithm<T>::totalScore() const
+template <typename Algorithm>
+IslandModel<Algorithm>::~IslandModel()
+{
+	_run = false;
+	for (unsigned i=0 ; i<_threads.size() ; i++)
+		_threads[i].join();
+}
+
+template <typename Algorithm>
+void IslandModel<Algorithm>::setMigration(MigrationTopology topology, unsigned interval, unsigned numberOfMigrants)
+{
+	_topology = topology;
+	_interval = interval;
+	_numberOfMigrants = numberOfMigrants;
+}
+
+template <typename Algorithm>
+void IslandModel<Algorithm>::setSeed(std::uint64_t seed)
+{
+	for (unsigned i=0 ; i<_islands.size() ; i++)
+	{
+		_islands[i]->setSeed(mixBits(seed + i));
+		_destinations[i].seed(mixBits(~seed - i));
+	}
+}
+
+template <typename Algorithm>
+void IslandModel<Algorithm>::run(bool blocking, bool enableLogging, std::ostream & outputStream)
 {
-	double scoreSum = 0.0;
+	//Don't run twice at the same time
+	stop();
+	
+	//The islands step through their generations here, the steady state mode would never come back to migrate
+	for (unsigned i=0 ; i<_islands.size() ; i++)
+		if (_islands[i]->_steadyState)
+			throw std::runtime_error("The islands can't run in the steady state mode");
+	
+	//Logging (the islands are silent, only the model logs)
+	_logEnable = enableLogging;
+	_logStream = std::ref(outputStream);
 	
-	for (auto it=_population.begin() ; it!=_population.end() ; it++)
+	//One queue for each pair of islands, large enough to hold a few migrations
+	const unsigned n = _islands.size();
+	_queues.clear();
+	for (unsigned i=0 ; i<n*n ; i++)
+		_queues.push_back(std::unique_ptr<LockFreeQueue<Migrant> >(i/n != i%n ? new LockFreeQueue<Migrant>(2*_numberOfMigrants) : nullptr));
+	
+	//Prepare every island before starting any thread (an island may receive migrants as soon as the others start)
+	for (unsigned i=0 ; i<n ; i++)
 	{
-		scoreSum += it->first;
+		Island & island = *_islands[i];
+		island._logEnable = false;
+		island.prepare();
 	}
 	
-	return scoreSum;
+	LOG("Running " << n << " islands");
+	
+	_error = nullptr;
+	_run = true;
+	for (unsigned i=0 ; i<n ; i++)
+		_threads.push_back(std::thread(&IslandModel<Algorithm>::evolve, this, i));
+	
+	if (blocking)
+		join();
 }
 
-template <typename T>
-Chromosome<T> GeneticAlgorithm<T>::chromosome(Score fitness) const
+template <typename Algorithm>
+void IslandModel<Algorithm>::stop()
 {
-	//Thanks to the (multi)map, the elements will always be sorted by ascending score.
+	if (_threads.empty())
+		return;
 	
-	double cumulativeFitness = 0.0;
+	if (_run)
+		LOG("User stopped the islands");
+	_run = false;
+	join();
+}
+
+template <typename Algorithm>
+void IslandModel<Algorithm>::join()
+{
+	for (unsigned i=0 ; i<_threads.size() ; i++)
+		_threads[i].join();
+	_threads.clear();
 	
-	for (auto it=_population.begin() ; it!=_population.end() ; it++)
+	if (_error)
 	{
-		cumulativeFitness += it->first;
-		if (fitness <= cumulativeFitness)
-			return {it->second};
+		std::exception_ptr error = _error;
+		_error = nullptr;
+		_logEnable = false;
+		std::rethrow_exception(error);
 	}
 	
-	//In case we didn't find anything, just return the best element.
-	return lastElement().second;
+	LOG("The islands are over. The best individual has a fitness score of " << bestScore() << ".");
+	_logEnable = false;
 }
 
-template <typename T>
-Chromosome<T> GeneticAlgorithm<T>::chromosome(unsigned index) const
+template <typename Algorithm>
+typename Algorithm::ChromosomeType IslandModel<Algorithm>::best()
 {
-	//Safety check
-	if (index >= _population.size())
-		return lastElement().second;
+	return _islands[bestIsland()]->best();
+}
+
+template <typename Algorithm>
+Score IslandModel<Algorithm>::bestScore()
+{
+	return _islands[bestIsland()]->bestScore();
+}
+
+template <typename Algorithm>
+unsigned IslandModel<Algorithm>::bestIsland()
+{
+	unsigned best = 0;
+	bool found = false;
+	Score bestScore = 0.0;
+	for (unsigned i=0 ; i<_islands.size() ; i++)
+	{
+		Island & island = *_islands[i];
+		std::lock_guard<std::mutex> lock(island._mutex);
+		
+		//No generation evaluated, no best chromosome (its score would be 0)
+		if (island._ranking.empty())
+			continue;
+		
+		const Score score = island._scores[island._ranking.back()];
+		if (!found || score > bestScore)
+		{
+			best = i;
+			bestScore = score;
+			found = true;
+		}
+	}
+	
+	return best;
+}
+
+template <typename Algorithm>
+Algorithm & IslandModel<Algorithm>::island(unsigned index)
+{
+	return *_islands.at(index);
+}
+
+template <typename Algorithm>
+unsigned IslandModel<Algorithm>::getNumberOfIslands() const
+{
+	return _islands.size();
+}
+
+template <typename Algorithm>
+void IslandModel<Algorithm>::evolve(unsigned index)
+{
+	Island & island = *_islands[index];
 	
-	//Move an iterator to the corresponding index and return the chromosome
-	auto it = _population.begin();
-	std::advance(it, index);
+	try
+	{
+		//Same loop as GeneticAlgorithm::evolve, with the migrations between the evaluation and the breeding
+		//Every island evaluates at least its first generation, even if another one is already over, so that each of them has a best chromosome
+		while (island._run)
+		{
+			if (island.evaluateGeneration())
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				LOG("Island " << index << " matched its ending criterion at generation " << island._generation);
+				break;
+			}
+			
+			if (!_run)
+				break;
+			
+			if (_islands.size() > 1 && _interval > 0 && island._generation % _interval == _interval - 1)
+				migrate(index);
+			
+			island.nextGeneration();
+		}
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_error)
+			_error = std::current_exception();
+	}
 	
-	return it->second;
+	//Once an island is over, all of them are (at the end of their current generation)
+	_run = false;
+	island.finish();
 }
 
-template <typename T>
-std::pair<Score, Chromosome<T> > GeneticAlgorithm<T>::lastElement() const
+template <typename Algorithm>
+void IslandModel<Algorithm>::migrate(unsigned index)
 {
-	return * std::prev(_population.end());
+	Island & island = *_islands[index];
+	const unsigned n = _islands.size();
+	
+	//Send (a full queue means the destination is late, then the migrants are dropped)
+	unsigned destination = (index + 1) % n;
+	if (_topology == MigrationTopology::Random)
+	{
+		destination = _destinations[index].below(n - 1);
+		destination += destination >= index;
+	}
+	
+	island.emigrate(_numberOfMigrants, [&](ChromosomeType const & chromosome, Score score)
+	{
+		for (unsigned to=0 ; to<n ; to++)
+		{
+			if (to == index || (_topology != MigrationTopology::FullyConnected && to != destination))
+				continue;
+			
+			_queues[index*n+to]->push([&](Migrant & migrant)
+			{
+				migrant.first = chromosome;
+				migrant.second = score;
+			});
+		}
+	});
+	
+	//Receive (the immigrants replace the worst chromosomes, half of the population at most)
+	Migrant & incoming = _incoming[index];
+	unsigned from = 0;
+	island.immigrate(island._populationSize / 2, [&](ChromosomeType & chromosome, Score & score)
+	{
+		for ( ; from<n ; from++)
+		{
+			if (from != index && _queues[from*n+index]->pop(incoming))
+			{
+				chromosome.swap(incoming.first);
+				score = incoming.second;
+				return true;
+			}
+		}
+		return false;
+	});
 }
 
+#endif
+
 } //namespace
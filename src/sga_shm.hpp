@@ -0,0 +1,725 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+#pragma once
+
+//Island model with one process per island (POSIX only, link with -lrt on old systems)
+
+#include "sga.hpp"
+
+#include <cstring>
+#include <cstddef>
+#include <cerrno>
+#include <limits>
+#include <mutex>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace SGA
+{
+
+/*******************/
+/** Shared memory **/
+/*******************/
+
+//Named POSIX shared memory segment mapped in the process (created filled with zeros if it doesn't exist yet)
+//It can also be locked between processes (like a mutex, the lock is released if the process dies)
+class SharedMemory
+{
+	public :
+		
+		SharedMemory(std::string const & name, std::size_t size)
+		 : _name(name), _size(size)
+		{
+			_descriptor = shm_open(name.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+			if (_descriptor < 0)
+				throw std::runtime_error("Cannot open the shared memory segment " + name + ": " + std::strerror(errno));
+			
+			//Every process asks for the same size, growing a new segment fills it with zeros
+			if (ftruncate(_descriptor, size) < 0)
+			{
+				const int error = errno;
+				close(_descriptor);
+				throw std::runtime_error("Cannot resize the shared memory segment " + name + ": " + std::strerror(error));
+			}
+			
+			_data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _descriptor, 0);
+			if (_data == MAP_FAILED)
+			{
+				const int error = errno;
+				close(_descriptor);
+				throw std::runtime_error("Cannot map the shared memory segment " + name + ": " + std::strerror(error));
+			}
+		}
+		
+		~SharedMemory()
+		{
+			munmap(_data, _size);
+			close(_descriptor);
+		}
+		
+		SharedMemory(SharedMemory const &) = delete;
+		SharedMemory & operator=(SharedMemory const &) = delete;
+		
+		void * data() const
+		{
+			return _data;
+		}
+		
+		//Remove the name of the segment (it is freed once every process unmapped it)
+		void unlink() const
+		{
+			shm_unlink(_name.c_str());
+		}
+		
+		//Wait until no other process (or other SharedMemory of this process) holds the lock of the segment, and take it
+		void lock()
+		{
+			while (flock(_descriptor, LOCK_EX) < 0)
+				if (errno != EINTR)
+					throw std::runtime_error("Cannot lock the shared memory segment " + _name + ": " + std::strerror(errno));
+		}
+		
+		//Same as lock() without the exception, for the destructors: returns false if the lock can't be taken
+		bool tryLock()
+		{
+			while (flock(_descriptor, LOCK_EX) < 0)
+				if (errno != EINTR)
+					return false;
+			return true;
+		}
+		
+		void unlock()
+		{
+			flock(_descriptor, LOCK_UN);
+		}
+	
+	private :
+		
+		std::string		_name;			//Name of the segment (starting with a /)
+		std::size_t		_size;			//Size of the segment in bytes
+		int				_descriptor;	//Open until the segment is unmapped, for the lock
+		void *			_data;			//Where the segment is mapped
+};
+
+//The genes are copied between the processes unit by unit: gene by gene, or word by word for the bit chromosomes
+template <typename T>
+struct GeneUnits
+{
+	typedef T Type;
+	
+	//Number of units holding the given number of genes
+	static unsigned count(unsigned length)
+	{
+		return length;
+	}
+};
+
+template <>
+struct GeneUnits<Bit>
+{
+	typedef std::uint64_t Type;
+	
+	static unsigned count(unsigned length)
+	{
+		return (length + 63) / 64;
+	}
+};
+
+template <typename Chromosome>
+auto geneUnits(Chromosome & chromosome) -> decltype(chromosome.data())
+{
+	return chromosome.data();
+}
+
+template <std::size_t N>
+std::uint64_t * geneUnits(BitChromosome<N> & chromosome)
+{
+	return chromosome.words();
+}
+
+template <std::size_t N>
+std::uint64_t const * geneUnits(BitChromosome<N> const & chromosome)
+{
+	return chromosome.words();
+}
+
+//Bounded queue of chromosomes between one producer process and one consumer process, same idea as LockFreeQueue
+//Each slot holds a serialized chromosome: its score, its length and its genes copied byte by byte (hence the trivially copyable genes)
+//The chromosomes are stored like in GeneticAlgorithm<T, N>, the bit chromosomes are copied word by word
+template <typename T, std::size_t N = 0>
+class SharedMemoryQueue
+{
+	typedef typename GeneUnits<T>::Type Unit;
+	
+	static_assert(std::is_trivially_copyable<Unit>::value, "The genes must be trivially copyable to be sent to another process");
+	static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "The queues between processes need lock-free atomics");
+	
+	typedef typename ChromosomeTraits<T, N>::Type ChromosomeType;
+	
+	public :
+		
+		//A segment left by another session (any other value than session, which can't be 0) is emptied
+		//The producer and the consumer must not open the queue at the same time (they lock another segment meanwhile)
+		SharedMemoryQueue(std::string const & name, unsigned capacity, unsigned maxChromosomeSize, std::uint64_t session)
+		 : _slots(capacity+1), _maxChromosomeSize(maxChromosomeSize),
+		   _slotSize(align(genesOffset() + GeneUnits<T>::count(maxChromosomeSize)*sizeof(Unit))),
+		   _memory(name, align(sizeof(Header)) + _slots*_slotSize)
+		{
+			_header = static_cast<Header *>(_memory.data());
+			_buffer = static_cast<unsigned char *>(_memory.data()) + align(sizeof(Header));
+			
+			//First opening in this session: the chromosomes left in the queue (and its counters) are stale
+			if (_header->session != session)
+			{
+				_header->head = 0;
+				_header->tail = 0;
+				_header->session = session;
+			}
+		}
+		
+		//Copy the chromosome at the back of the queue (producer only)
+		bool push(ChromosomeType const & chromosome, Score score)
+		{
+			if (chromosome.size() > _maxChromosomeSize)
+				throw std::runtime_error("The chromosome is too long to be sent to another process");
+			
+			const std::uint32_t tail = _header->tail.load(std::memory_order_relaxed);
+			const std::uint32_t next = (tail + 1) % _slots;
+			if (next == _header->head.load(std::memory_order_acquire))
+				return false;
+			
+			unsigned char * slot = _buffer + tail*_slotSize;
+			SlotHeader * header = reinterpret_cast<SlotHeader *>(slot);
+			header->score = score;
+			header->length = chromosome.size();
+			if (!chromosome.empty())
+				std::memcpy(slot + genesOffset(), geneUnits(chromosome), GeneUnits<T>::count(chromosome.size())*sizeof(Unit));
+			
+			_header->tail.store(next, std::memory_order_release);
+			return true;
+		}
+		
+		//Copy the chromosome at the front of the queue (consumer only)
+		bool pop(ChromosomeType & chromosome, Score & score)
+		{
+			const std::uint32_t head = _header->head.load(std::memory_order_relaxed);
+			if (head == _header->tail.load(std::memory_order_acquire))
+				return false;
+			
+			unsigned char const * slot = _buffer + head*_slotSize;
+			SlotHeader const * header = reinterpret_cast<SlotHeader const *>(slot);
+			score = header->score;
+			ChromosomeTraits<T, N>::resize(chromosome, header->length);
+			if (!chromosome.empty())
+				std::memcpy(geneUnits(chromosome), slot + genesOffset(), GeneUnits<T>::count(chromosome.size())*sizeof(Unit));
+			
+			_header->head.store((head + 1) % _slots, std::memory_order_release);
+			return true;
+		}
+		
+		void unlink() const
+		{
+			_memory.unlink();
+		}
+	
+	private :
+		
+		//Everything starts at 0 in a new segment
+		struct Header
+		{
+			std::atomic<std::uint64_t>	session;	//Session of the islands which last opened the queue
+			std::atomic<std::uint32_t>	head;		//Next slot to pop (written by the consumer)
+			std::atomic<std::uint32_t>	tail;		//Next slot to push (written by the producer)
+		};
+		
+		struct SlotHeader
+		{
+			Score			score;	//Fitness score of the chromosome
+			std::uint32_t	length;	//Number of genes
+		};
+		
+		//Round up to a multiple of the strictest alignment
+		static std::size_t align(std::size_t size)
+		{
+			const std::size_t alignment = std::max(alignof(std::max_align_t), alignof(Unit));
+			return (size + alignment - 1) / alignment * alignment;
+		}
+		
+		static std::size_t genesOffset()
+		{
+			return (sizeof(SlotHeader) + alignof(Unit) - 1) / alignof(Unit) * alignof(Unit);
+		}
+		
+		std::uint32_t		_slots;				//One more slot than the capacity, to tell a full queue from an empty one
+		unsigned			_maxChromosomeSize;	//Number of genes a slot can hold
+		std::size_t			_slotSize;			//Size of a slot in bytes
+		SharedMemory		_memory;			//The segment holding the header and the slots
+		Header *			_header;			//Counters at the beginning of the segment
+		unsigned char *		_buffer;			//Slots after the counters
+};
+
+/*********************/
+/** Process islands **/
+/*********************/
+
+/* One island of an island model where every island runs in its own process (one per NUMA node for instance).
+ * The processes find each other by name: start numberOfIslands processes with the same name and a different index.
+ * Each island allocates its population in its own process, so pinning the process to a node (numactl --cpunodebind=N --membind=N)
+ * keeps the population in the memory of this node: only the migrants cross the nodes, through the shared memory queues.
+ *
+ * The islands alive together form a session: each one records its process id in the control segment, and the last one to be destroyed
+ * removes the segments. The segments left by crashed processes are reset by the first island of the next session (an island finding
+ * no live process in them), so they only stay in /dev/shm until then, or until they are removed by hand (rm /dev/shm/<name>-*).
+ */
+template <typename Algorithm>
+class ProcessIsland
+{
+	typedef typename Algorithm::GeneType T;
+	typedef typename Algorithm::ChromosomeType ChromosomeType;
+	typedef typename Algorithm::EngineType Island;
+	typedef SharedMemoryQueue<T, Algorithm::ChromosomeLength> Queue;
+	
+	public :
+		
+		//Constructor (the arguments after the number of islands are given to the constructor of the island)
+		template <typename... Args>
+		ProcessIsland(std::string const & name, unsigned index, unsigned numberOfIslands, Args&&... args);
+		
+		//Destructor (the last island of the session removes the shared memory segments)
+		~ProcessIsland();
+		
+		//Same as IslandModel::setMigration
+		void setMigration(MigrationTopology topology, unsigned interval, unsigned numberOfMigrants);
+		
+		//Set how long run() waits for the other islands before it throws (60 seconds by default, 0 to wait forever)
+		void setStartTimeout(double seconds);
+		
+		//Make the island evolve until one of the islands reaches its ending criterion or stop() is called in any process
+		//The islands start together, once the numberOfIslands processes have called run(), and each one evaluates at least its first generation
+		//All the islands must have the same migration parameters and maximum chromosome size, and they can't run in the steady state mode
+		void run(bool enableLogging = false, std::ostream & outputStream = std::cout);
+		
+		//Stop all the islands (can be called from another thread, once the islands have started)
+		void stop();
+		
+		//Get the best chromosome of this island
+		ChromosomeType best();
+		
+		//Get the best score of all the islands (as published at their last generation, the islands which haven't published any are ignored)
+		Score bestScore() const;
+		
+		//Get the island to set its parameters (before calling run)
+		Algorithm & island();
+	
+	private :
+		
+		//Shared by all the processes (filled with zeros in a new segment), written under the lock of the segment except stop and the best scores
+		struct Control
+		{
+			std::atomic<std::uint64_t>	session;	//Stamp of the islands alive together, 0 in a new segment
+			std::atomic<std::uint32_t>	removed;	//Set by the last island when it removes the segments
+			std::atomic<std::uint32_t>	stop;		//Set when the islands must stop (cleared when the islands start a run)
+			std::atomic<std::uint32_t>	round;		//Number of runs started, for the islands waiting for the others
+		};
+		
+		//Followed by one member per island
+		struct Member
+		{
+			std::atomic<std::int32_t>	process;	//Process id of the island, 0 if it isn't attached
+			std::atomic<std::uint32_t>	arrived;	//Set while the island waits for the others to start a run
+		};
+		
+		Control * control() const;
+		Member * members() const;
+		
+		//Best score of each island after the members, stored as bits since std::atomic<double> is not guaranteed to be lock-free
+		//(NaN until the island publishes one)
+		std::atomic<std::uint64_t> * bestScores() const;
+		
+		//Open the control segment and record the process of the island, starting a new session if no island is alive
+		void attach();
+		
+		//True if an island of the session is attached in a live process
+		bool isAlive(unsigned index) const;
+		
+		//Publish the best score of an island
+		void publish(unsigned index, Score score);
+		
+		//Wait until every island has called run(), the last one clears the stop flag and the best scores of the last run
+		//An island which dies while waiting is counted once with the one replacing it, throws if the islands don't all arrive before the timeout
+		void waitForIslands();
+		
+		//Send the best chromosomes of the island and receive the ones sent to it
+		void migrate();
+		
+		//Name of the queue from island i to island j
+		std::string queueName(unsigned from, unsigned to) const;
+		
+		std::string											_name;				//Prefix of the names of the shared memory segments
+		unsigned											_index;				//Index of this island
+		unsigned											_numberOfIslands;	//Number of processes
+		std::unique_ptr<Algorithm>							_island;			//The population of this process
+		std::unique_ptr<SharedMemory>						_control;			//Session, stop flag, members and best scores
+		std::uint64_t										_session;			//Session joined by the island
+		std::vector<std::unique_ptr<Queue> >				_outgoing;			//Queues to each island (null for this one)
+		std::vector<std::unique_ptr<Queue> >				_incoming;			//Queues from each island (null for this one)
+		Xoshiro256											_destinations;		//Generator picking the destination (random topology)
+		MigrationTopology									_topology;			//Where the migrants go
+		unsigned											_interval;			//Number of generations between two migrations
+		unsigned											_numberOfMigrants;	//Number of chromosomes sent at each migration
+		double												_startTimeout;		//Seconds run() waits for the other islands (0 for no limit)
+		
+		//Logging
+		bool 												_logEnable;			//Boolean used to know if the logging is enabled
+		std::reference_wrapper<std::ostream>				_logStream;			//Stream to which messages must be logged (std::ostream& is not copyable)
+};
+
+template <typename Algorithm>
+template <typename... Args>
+ProcessIsland<Algorithm>::ProcessIsland(std::string const & name, unsigned index, unsigned numberOfIslands, Args&&... args)
+ : _name(name), _index(index), _numberOfIslands(numberOfIslands), _island(new Algorithm(args...)), _session(0), _destinations(Random::engine()()),
+   _topology(MigrationTopology::Ring), _interval(10), _numberOfMigrants(1), _startTimeout(60.0), _logEnable(false), _logStream(std::cout)
+{
+	static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "The control segment shared between processes needs lock-free atomics");
+	
+	if (index >= numberOfIslands)
+		throw std::runtime_error("The index of the island must be lower than the number of islands");
+	
+	attach();
+}
+
+template <typename Algorithm>
+ProcessIsland<Algorithm>::~ProcessIsland()
+{
+	//A destructor can't throw: without the lock, the island only leaves the session (the next session resets the segments it doesn't remove)
+	if (!_control->tryLock())
+	{
+		members()[_index].arrived = 0;
+		members()[_index].process = 0;
+		return;
+	}
+	
+	std::lock_guard<SharedMemory> lock(*_control, std::adopt_lock);
+	members()[_index].process = 0;
+	members()[_index].arrived = 0;
+	for (unsigned i=0 ; i<_numberOfIslands ; i++)
+		if (isAlive(i))
+			return;
+	
+	//Last one out: remove every segment so that the next session starts from scratch
+	//An island opening the control segment meanwhile sees the removed flag once it gets the lock, and opens a new one
+	//(the name goes first: a crash in between can't leave a segment which every island would open and leave again)
+	_control->unlink();
+	control()->removed = 1;
+	for (unsigned from=0 ; from<_numberOfIslands ; from++)
+		for (unsigned to=0 ; to<_numberOfIslands ; to++)
+			if (from != to)
+				shm_unlink(queueName(from, to).c_str());
+}
+
+template <typename Algorithm>
+void ProcessIsland<Algorithm>::setMigration(MigrationTopology topology, unsigned interval, unsigned numberOfMigrants)
+{
+	_topology = topology;
+	_interval = interval;
+	_numberOfMigrants = numberOfMigrants;
+}
+
+template <typename Algorithm>
+void ProcessIsland<Algorithm>::setStartTimeout(double seconds)
+{
+	if (seconds < 0)
+		throw std::runtime_error("The start timeout can't be negative");
+	
+	_startTimeout = seconds;
+}
+
+template <typename Algorithm>
+void ProcessIsland<Algorithm>::run(bool enableLogging, std::ostream & outputStream)
+{
+	Island & island = *_island;
+	
+	//The island steps through its generations here, the steady state mode would never come back to migrate
+	if (island._steadyState)
+		throw std::runtime_error("The islands can't run in the steady state mode");
+	
+	//Logging (the island is silent, the logs are prefixed by its index)
+	_logEnable = enableLogging;
+	_logStream = std::ref(outputStream);
+	
+	//Open the queues with every other island (the slots must fit the longest chromosome)
+	//Under the lock of the session, so that only the first island to open a queue empties the one left by a previous session
+	{
+		std::lock_guard<SharedMemory> lock(*_control);
+		_outgoing.clear();
+		_incoming.clear();
+		_outgoing.resize(_numberOfIslands);
+		_incoming.resize(_numberOfIslands);
+		for (unsigned other=0 ; other<_numberOfIslands ; other++)
+		{
+			if (other == _index)
+				continue;
+			
+			_outgoing[other].reset(new Queue(queueName(_index, other), 2*_numberOfMigrants, island._maxChromosomeSize, _session));
+			_incoming[other].reset(new Queue(queueName(other, _index), 2*_numberOfMigrants, island._maxChromosomeSize, _session));
+		}
+	}
+	
+	island._logEnable = false;
+	island.prepare();
+	
+	LOG("Island " << _index << " of " << _numberOfIslands << " is waiting for the other islands");
+	waitForIslands();
+	LOG("Island " << _index << " of " << _numberOfIslands << " is running");
+	
+	//Same loop as GeneticAlgorithm::evolve, with the migrations between the evaluation and the breeding
+	//The island evaluates at least its first generation, even if another one is already over, so that it has a best chromosome
+	Control * control = this->control();
+	while (island._run)
+	{
+		//Nothing to publish if the budgets ended the first generation before any chromosome was evaluated
+		const bool over = island.evaluateGeneration();
+		if (!island._ranking.empty())
+			publish(_index, island._scores[island._ranking.back()]);
+		
+		if (over)
+		{
+			LOG("Island " << _index << " matched its ending criterion at generation " << island._generation);
+			break;
+		}
+		
+		if (control->stop)
+			break;
+		
+		if (_numberOfIslands > 1 && _interval > 0 && island._generation % _interval == _interval - 1)
+			migrate();
+		
+		island.nextGeneration();
+	}
+	
+	//Once an island is over, all of them are
+	control->stop = 1;
+	island.finish();
+	
+	LOG("Island " << _index << " is over. The best individual of all the islands has a fitness score of " << bestScore() << ".");
+	_logEnable = false;
+}
+
+template <typename Algorithm>
+void ProcessIsland<Algorithm>::stop()
+{
+	control()->stop = 1;
+}
+
+template <typename Algorithm>
+typename Algorithm::ChromosomeType ProcessIsland<Algorithm>::best()
+{
+	return _island->best();
+}
+
+template <typename Algorithm>
+Score ProcessIsland<Algorithm>::bestScore() const
+{
+	//No island has published a score: 0 like GeneticAlgorithm::bestScore()
+	Score best = 0.0;
+	bool found = false;
+	for (unsigned i=0 ; i<_numberOfIslands ; i++)
+	{
+		Score score;
+		const std::uint64_t bits = bestScores()[i];
+		std::memcpy(&score, &bits, sizeof(score));
+		if (std::isnan(score))
+			continue;
+		
+		best = found ? std::max(best, score) : score;
+		found = true;
+	}
+	
+	return best;
+}
+
+template <typename Algorithm>
+Algorithm & ProcessIsland<Algorithm>::island()
+{
+	return *_island;
+}
+
+template <typename Algorithm>
+typename ProcessIsland<Algorithm>::Control * ProcessIsland<Algorithm>::control() const
+{
+	return static_cast<Control *>(_control->data());
+}
+
+template <typename Algorithm>
+typename ProcessIsland<Algorithm>::Member * ProcessIsland<Algorithm>::members() const
+{
+	return reinterpret_cast<Member *>(static_cast<unsigned char *>(_control->data()) + sizeof(Control));
+}
+
+template <typename Algorithm>
+std::atomic<std::uint64_t> * ProcessIsland<Algorithm>::bestScores() const
+{
+	return reinterpret_cast<std::atomic<std::uint64_t> *>(members() + _numberOfIslands);
+}
+
+template <typename Algorithm>
+void ProcessIsland<Algorithm>::attach()
+{
+	const std::size_t size = sizeof(Control) + _numberOfIslands*(sizeof(Member) + sizeof(std::uint64_t));
+	while (true)
+	{
+		//The last island of the previous session may have removed the segment after this one opened it
+		_control.reset(new SharedMemory(_name + "-control", size));
+		_control->lock();
+		if (!control()->removed)
+			break;
+		_control->unlock();
+	}
+	
+	std::lock_guard<SharedMemory> lock(*_control, std::adopt_lock);
+	Control * control = this->control();
+	Member * members = this->members();
+	
+	bool alive = false;
+	for (unsigned i=0 ; i<_numberOfIslands ; i++)
+		alive = alive || isAlive(i);
+	
+	if (!alive)
+	{
+		//New segment, or left by crashed processes: new session, no island waiting and no best score yet
+		//(the other islands can't publish theirs before all of them run)
+		const std::uint64_t time = std::chrono::system_clock::now().time_since_epoch().count();
+		control->session = mixBits(time ^ (std::uint64_t(getpid()) << 32)) | 1;
+		control->stop = 0;
+		for (unsigned i=0 ; i<_numberOfIslands ; i++)
+		{
+			members[i].process = 0;
+			members[i].arrived = 0;
+			publish(i, std::numeric_limits<Score>::quiet_NaN());
+		}
+	}
+	else if (isAlive(_index))
+	{
+		throw std::runtime_error("The island " + std::to_string(_index) + " of " + _name + " is already running in the process "
+			+ std::to_string(members[_index].process));
+	}
+	
+	members[_index].process = getpid();
+	_session = control->session;
+}
+
+template <typename Algorithm>
+bool ProcessIsland<Algorithm>::isAlive(unsigned index) const
+{
+	//A process which can't be signaled (EPERM) exists all the same
+	const pid_t process = members()[index].process;
+	return process > 0 && (kill(process, 0) == 0 || errno == EPERM);
+}
+
+template <typename Algorithm>
+void ProcessIsland<Algorithm>::publish(unsigned index, Score score)
+{
+	std::uint64_t bits;
+	std::memcpy(&bits, &score, sizeof(bits));
+	bestScores()[index] = bits;
+}
+
+template <typename Algorithm>
+void ProcessIsland<Algorithm>::waitForIslands()
+{
+	Control * control = this->control();
+	Member * members = this->members();
+	
+	//Read the round before arriving: it can't change until every island has arrived
+	std::uint32_t round;
+	{
+		std::lock_guard<SharedMemory> lock(*_control);
+		round = control->round;
+		members[_index].arrived = 1;
+		
+		unsigned arrived = 0;
+		for (unsigned i=0 ; i<_numberOfIslands ; i++)
+			arrived += members[i].arrived;
+		
+		if (arrived == _numberOfIslands)
+		{
+			//Last one in: start the run from a clean state (nobody reads or writes it until the round changes)
+			for (unsigned i=0 ; i<_numberOfIslands ; i++)
+			{
+				publish(i, std::numeric_limits<Score>::quiet_NaN());
+				members[i].arrived = 0;
+			}
+			control->stop = 0;
+			control->round++;
+			return;
+		}
+	}
+	
+	//Until the last island arrives, or the timeout: this island leaves the round then, unless the last one came meanwhile
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while (control->round == round)
+	{
+		if (_startTimeout > 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= _startTimeout)
+		{
+			std::lock_guard<SharedMemory> lock(*_control);
+			if (control->round != round)
+				return;
+			
+			members[_index].arrived = 0;
+			std::string missing;
+			for (unsigned i=0 ; i<_numberOfIslands ; i++)
+				if (i != _index && !members[i].arrived)
+					missing += " " + std::to_string(i) + (members[i].process == 0 ? " (not started)" : isAlive(i) ? " (not running)" : " (dead)");
+			throw std::runtime_error("The islands" + missing + " of " + _name + " didn't start within " + std::to_string(_startTimeout) + " seconds");
+		}
+		
+		usleep(1000);
+	}
+}
+
+template <typename Algorithm>
+void ProcessIsland<Algorithm>::migrate()
+{
+	Island & island = *_island;
+	const unsigned n = _numberOfIslands;
+	
+	//Send (a full queue means the destination is late, then the migrants are dropped)
+	unsigned destination = (_index + 1) % n;
+	if (_topology == MigrationTopology::Random)
+	{
+		destination = _destinations.below(n - 1);
+		destination += destination >= _index;
+	}
+	
+	island.emigrate(_numberOfMigrants, [&](ChromosomeType const & chromosome, Score score)
+	{
+		for (unsigned to=0 ; to<n ; to++)
+			if (to != _index && (_topology == MigrationTopology::FullyConnected || to == destination))
+				_outgoing[to]->push(chromosome, score);
+	});
+	
+	//Receive (the immigrants replace the worst chromosomes, half of the population at most)
+	unsigned from = 0;
+	island.immigrate(island._populationSize / 2, [&](ChromosomeType & chromosome, Score & score)
+	{
+		for ( ; from<n ; from++)
+			if (from != _index && _incoming[from]->pop(chromosome, score))
+				return true;
+		return false;
+	});
+}
+
+template <typename Algorithm>
+std::string ProcessIsland<Algorithm>::queueName(unsigned from, unsigned to) const
+{
+	return _name + "-" + std::to_string(from) + "-" + std::to_string(to);
+}
+
+} //namespace
@@ -32,4 +32,12 @@ class GA : public SGA::GeneticAlgorithm<Gene>
 		{
 			//your code here, if you want/need
 		}
+		
+		//OPTIONAL: compute the scores of count chromosomes at once (useful to share some setup or vectorize across individuals)
+		virtual void scoreBatch(SGA::Chromosome<Gene> const * chromosomes, SGA::Score * scores, unsigned count) const override
+		{
+			//your code here, if you want/need (scores[i] is the score of chromosomes[i])
+			//by default, call score() on each chromosome (remove this line if you write your own)
+			SGA::GeneticAlgorithm<Gene>::scoreBatch(chromosomes, scores, count);
+		}
 };
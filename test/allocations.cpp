@@ -0,0 +1,130 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: once the first generations have sized the buffers, a generation must not allocate any memory,
+ * whatever the ending criterion (with chromosomes of a fixed length, and of a varying length with mutations which keep it).
+ */
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "../src/sga.hpp"
+
+INIT_RANDOM();
+
+//Every allocation of the process is counted (the operators are not inlined, so the compiler doesn't pair a new expression with free())
+std::atomic<unsigned long long> allocations(0);
+
+__attribute__((noinline)) void * operator new(std::size_t size)
+{
+	allocations++;
+	if (void * memory = std::malloc(size > 0 ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void * memory) noexcept
+{
+	std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void * memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+//Number of allocations at the end of each generation, taken when the ending criterion is checked
+template <typename Derived, std::size_t N>
+class Counting : public SGA::StaticGeneticAlgorithm<Derived, unsigned, N>
+{
+	typedef SGA::StaticGeneticAlgorithm<Derived, unsigned, N> Base;
+
+	public :
+
+		std::vector<unsigned long long> counts;
+
+		Counting()
+		{
+			counts.reserve(1000);
+			this->setMainParameters(100, 0.3);
+			this->setElitism(2);
+		}
+
+		unsigned randomGene() const
+		{
+			return SGA::Random::get(0u, 9u);
+		}
+
+		SGA::Score score(typename Base::ChromosomeType const & chromosome) const
+		{
+			SGA::Score score = 0.0;
+			for (unsigned i=0 ; i<chromosome.size() ; i++)
+				score += chromosome[i] * (i % 3 + 1);
+			return score;
+		}
+
+		bool isEvolutionOver()
+		{
+			counts.push_back(allocations);
+			return Base::isEvolutionOver();
+		}
+};
+
+class Fixed : public Counting<Fixed, 32> {};
+class Varying : public Counting<Varying, 0> {};
+
+unsigned failures = 0;
+
+//Run an algorithm for 60 generations and check that the last 50 didn't allocate
+template <typename Algorithm>
+void check(std::string const & test, Algorithm & algorithm, SGA::EndingCriterion criterion)
+{
+	algorithm.setSeed(7);
+	algorithm.setEndingCriterion(criterion, 1e9, 1000);
+	algorithm.setBudgets(0.0, 0.0, 0, 60);
+	algorithm.counts.clear();
+	algorithm.run(true);
+
+	if (algorithm.counts.size() != 60)
+	{
+		std::cout << "FAILED: " << test << ": " << algorithm.counts.size() << " generations instead of 60" << std::endl;
+		failures++;
+		return;
+	}
+
+	const unsigned long long allocated = algorithm.counts.back() - algorithm.counts[9];
+	if (allocated > 0)
+	{
+		std::cout << "FAILED: " << test << ": " << allocated << " allocations in the last 50 generations" << std::endl;
+		failures++;
+	}
+}
+
+int main()
+{
+	const SGA::EndingCriterion criteria[] = {SGA::EndingCriterion::BestScore, SGA::EndingCriterion::MaxScore, SGA::EndingCriterion::NeverStop};
+	char const * names[] = {"BestScore", "MaxScore", "NeverStop"};
+
+	for (unsigned c=0 ; c<3 ; c++)
+	{
+		Fixed fixed;
+		check(std::string("fixed length, ") + names[c], fixed, criteria[c]);
+
+		Varying varying;
+		varying.setChromosomesSize(32, 32);
+		check(std::string("varying length, ") + names[c], varying, criteria[c]);
+
+		Fixed parallel;
+		parallel.setParallelEvaluation(true, 3);
+		check(std::string("fixed length on 3 threads, ") + names[c], parallel, criteria[c]);
+	}
+
+	std::cout << (failures ? "allocations: FAILED" : "allocations: ok") << std::endl;
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
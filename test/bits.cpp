@@ -0,0 +1,185 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: the word-level operators of the bit chromosomes must give the same children as the generic ones for the same
+ * random numbers, keep the bits of complementary parents complementary, and never set the unused bits of the last word.
+ */
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+
+#include "../src/sga.hpp"
+#include "check.hpp"
+
+INIT_RANDOM();
+
+//The bits past the size of the chromosome are 0
+template <std::size_t N>
+bool cleanTail(SGA::BitChromosome<N> const & chromosome)
+{
+	const unsigned used = (chromosome.size() + 63) / 64;
+	for (unsigned w=0 ; w<chromosome.numberOfWords() ; w++)
+		if (chromosome.words()[w] & ~(w < used ? SGA::wordMask(w, 0, chromosome.size()) : 0))
+			return false;
+	return true;
+}
+
+bool same(SGA::BitChromosome<0> const & bits, std::vector<SGA::Bit> const & genes)
+{
+	if (bits.size() != genes.size())
+		return false;
+	for (unsigned i=0 ; i<genes.size() ; i++)
+		if (bits[i] != genes[i])
+			return false;
+	return true;
+}
+
+//Bit chromosome of the given size with random bits, and the same bits as generic genes
+void randomParent(unsigned size, SGA::RandomStream & random, SGA::BitChromosome<0> & bits, std::vector<SGA::Bit> & genes)
+{
+	bits = SGA::BitChromosome<0>(size);
+	genes.assign(size, false);
+	for (unsigned i=0 ; i<size ; i++)
+		bits[i] = genes[i] = random.below(2) == 1;
+}
+
+enum class Operator { Uniform, OnePoint, TwoPoint, Swap };
+
+template <typename Genes>
+bool cross(Operator type, Genes & first, Genes & second, unsigned size, SGA::RandomStream & random)
+{
+	if (type == Operator::Uniform)
+		return SGA::uniformCrossover(first, second, size, random);
+	if (type == Operator::OnePoint)
+		return SGA::onePointCrossover(first, second, size, random);
+	if (type == Operator::TwoPoint)
+		return SGA::twoPointCrossover(first, second, size, random);
+
+	unsigned begin, end;
+	SGA::randomSegment(size, random, begin, end);
+	return SGA::swapGenes(first, second, begin, end+1);
+}
+
+//Apply an operator to the bit chromosomes and to the generic genes, from the same stream
+void compare(std::string const & name, unsigned size, Operator type)
+{
+	SGA::RandomStream random(size);
+	SGA::BitChromosome<0> a, b;
+	std::vector<SGA::Bit> x, y;
+	randomParent(size, random, a, x);
+	randomParent(size, random, b, y);
+
+	for (unsigned k=0 ; k<20 ; k++)
+	{
+		SGA::RandomStream wordStream(k), geneStream(k);
+		const bool wordChanged = cross(type, a, b, size, wordStream);
+		const bool geneChanged = cross(type, x, y, size, geneStream);
+		if (!same(a, x) || !same(b, y) || wordChanged != geneChanged)
+		{
+			expect(false, name + " on " + std::to_string(size) + " bits differs from the generic one");
+			return;
+		}
+		if (!cleanTail(a) || !cleanTail(b))
+		{
+			expect(false, name + " on " + std::to_string(size) + " bits set the unused bits");
+			return;
+		}
+	}
+}
+
+//Counts the chromosomes whose unused bits were set when they were scored
+template <std::size_t N>
+class Checked : public SGA::StaticGeneticAlgorithm<Checked<N>, SGA::Bit, N>
+{
+	typedef SGA::StaticGeneticAlgorithm<Checked<N>, SGA::Bit, N> Base;
+
+	public :
+
+		mutable std::atomic<unsigned> dirty;
+
+		Checked() : dirty(0)
+		{
+			this->setMainParameters(60, 0.5);
+			this->setEndingCriterion(SGA::EndingCriterion::NeverStop);
+			this->setBudgets(0.0, 0.0, 0, 30);
+		}
+
+		SGA::Bit randomGene() const
+		{
+			return SGA::Random::get(0u, 1u) == 1;
+		}
+
+		SGA::Score score(typename Base::ChromosomeType const & chromosome) const
+		{
+			if (!cleanTail(chromosome))
+				dirty++;
+			return chromosome.count();
+		}
+};
+
+template <typename Algorithm>
+void run(std::string const & name, Algorithm & algorithm)
+{
+	const SGA::MutationType mutations[] = {SGA::MutationType::PerGene, SGA::MutationType::RandomGenes};
+	const SGA::CrossoverType crossovers[] = {SGA::CrossoverType::Segments, SGA::CrossoverType::OnePoint, SGA::CrossoverType::TwoPoint, SGA::CrossoverType::Uniform};
+	for (SGA::MutationType mutation : mutations)
+	{
+		for (SGA::CrossoverType crossover : crossovers)
+		{
+			algorithm.setMutationType(mutation);
+			algorithm.setCrossoverType(crossover);
+			algorithm.dirty = 0;
+			algorithm.run(true);
+			if (algorithm.dirty > 0)
+			{
+				expect(false, name + ": " + std::to_string(algorithm.dirty) + " chromosomes had unused bits set");
+				return;
+			}
+		}
+	}
+}
+
+int main()
+{
+	//Sizes around the words, and more than 64 words (the random words are drawn 64 at a time)
+	const unsigned sizes[] = {1, 2, 63, 64, 65, 127, 128, 130, 4095, 4096, 4097, 5000};
+	for (unsigned size : sizes)
+	{
+		compare("the uniform crossover", size, Operator::Uniform);
+		compare("the one-point crossover", size, Operator::OnePoint);
+		compare("the two-point crossover", size, Operator::TwoPoint);
+		compare("swapGenes()", size, Operator::Swap);
+
+		//Complementary parents: each position holds one bit set, whichever child gets it
+		SGA::RandomStream random(size);
+		SGA::BitChromosome<0> a(size), b(size);
+		for (unsigned i=0 ; i<size ; i++)
+			b[i] = !(a[i] = random.below(2) == 1);
+		for (unsigned k=0 ; k<20 ; k++)
+			SGA::uniformCrossover(a, b, size, random);
+
+		bool complementary = true;
+		for (unsigned i=0 ; i<size ; i++)
+			complementary = complementary && a[i] != b[i];
+		expect(a.count() + b.count() == size && complementary, "the uniform crossover of complementary parents of " + std::to_string(size) + " bits lost bits");
+
+		//Random bits up to the end of the chromosome, from any position
+		SGA::BitChromosome<0> bits(size);
+		for (unsigned begin=0 ; begin<size ; begin+=std::max(1u, size/7))
+			SGA::randomizeBits(bits, begin, size, random);
+		expect(cleanTail(bits), "randomizeBits() set the unused bits of " + std::to_string(size) + " bits");
+	}
+
+	//The unused bits stay 0 through whole runs, with a fixed size and with sizes shrinking and growing between the chromosomes
+	Checked<100> fixed;
+	run("fixed size", fixed);
+
+	Checked<0> varying;
+	varying.setChromosomesSize(70, 130);
+	run("varying size", varying);
+
+	return report("bits");
+}
@@ -0,0 +1,279 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: when a budget stops the evaluation of a generation, the published population must only hold evaluated chromosomes,
+ * best() and bestScore() must give the best chromosome found so far (with elitism), and the budgets must be respected: the budgets of time
+ * within a few milliseconds, even when a chunk of the population takes much longer to evaluate.
+ */
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+#include <ctime>
+
+#include "../src/sga.hpp"
+
+INIT_RANDOM();
+
+class GA : public SGA::GeneticAlgorithm<unsigned>
+{
+	public :
+	
+		mutable std::atomic<unsigned long long> evaluations;	//Number of calls to score()
+		mutable std::atomic<unsigned long long> batches;		//Number of calls to scoreBatch()
+		mutable SGA::Score record;								//Best score ever computed
+		mutable std::mutex mutex;								//Protects the record
+		unsigned delay;											//Microseconds taken by each evaluation
+		bool busy;												//Spend the delay computing instead of sleeping (for the budgets of processor time)
+		unsigned geneDelay;										//Microseconds taken by each random gene
+		
+		GA(unsigned microseconds = 0, bool busyWaiting = false)
+		 : SGA::GeneticAlgorithm<unsigned>(), evaluations(0), batches(0), record(-std::numeric_limits<SGA::Score>::infinity()), delay(microseconds), busy(busyWaiting), geneDelay(0)
+		{
+			setMainParameters(100, 0.2);
+			setChromosomesSize(20, 20);
+			setEndingCriterion(SGA::EndingCriterion::NeverStop);
+			setElitism(1);
+		}
+		
+		virtual unsigned randomGene() const override
+		{
+			if (geneDelay > 0)
+				std::this_thread::sleep_for(std::chrono::microseconds(geneDelay));
+			return SGA::Random::get(0u, 9u);
+		}
+		
+		virtual void scoreBatch(SGA::Chromosome<unsigned> const * chromosomes, SGA::Score * scores, unsigned count) const override
+		{
+			batches++;
+			SGA::GeneticAlgorithm<unsigned>::scoreBatch(chromosomes, scores, count);
+		}
+		
+		//Negative scores, so that a missing score (0) would look better than the real ones
+		virtual SGA::Score score(SGA::Chromosome<unsigned> const & chromosome) const override
+		{
+			if (delay > 0 && busy)
+			{
+				const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::microseconds(delay);
+				while (std::chrono::steady_clock::now() < end);
+			}
+			else if (delay > 0)
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(delay));
+			}
+			
+			SGA::Score score = -1000.0;
+			for (unsigned i=0 ; i<chromosome.size() ; i++)
+				score += chromosome[i] * (i % 3 + 1);
+			
+			evaluations++;
+			std::lock_guard<std::mutex> lock(mutex);
+			record = std::max(record, score);
+			return score;
+		}
+		
+		//Score a chromosome without counting it
+		SGA::Score check(SGA::Chromosome<unsigned> const & chromosome) const
+		{
+			SGA::Score score = -1000.0;
+			for (unsigned i=0 ; i<chromosome.size() ; i++)
+				score += chromosome[i] * (i % 3 + 1);
+			return score;
+		}
+};
+
+unsigned failures = 0;
+
+void fail(std::string const & test, std::string const & message)
+{
+	std::cout << "FAILED: " << test << ": " << message << std::endl;
+	failures++;
+}
+
+//Run an algorithm and check what it publishes, and how long it took (in processor time if asked, which the other processes can't slow down)
+void check(std::string const & test, GA & algorithm, double maxMilliseconds = 0.0, bool processorTime = false)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const std::clock_t startClock = std::clock();
+	algorithm.run(true);
+	const double milliseconds = processorTime ? 1000.0 * (std::clock() - startClock) / CLOCKS_PER_SEC : std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	
+	if (maxMilliseconds > 0.0 && milliseconds > maxMilliseconds)
+		fail(test, "took " + std::to_string(milliseconds) + (processorTime ? " ms of processor time" : " ms"));
+	
+	//Every published chromosome has been evaluated and has its own score
+	SGA::RaggedPopulation<unsigned> population;
+	std::vector<SGA::Score> scores;
+	algorithm.getPopulation(population, scores);
+	if (population.empty())
+	{
+		fail(test, "empty population");
+		return;
+	}
+	
+	for (unsigned i=0 ; i<population.size() ; i++)
+	{
+		SGA::Chromosome<unsigned> chromosome;
+		population.get(i, chromosome);
+		if (std::isnan(scores[i]) || scores[i] != algorithm.check(chromosome))
+		{
+			fail(test, "chromosome " + std::to_string(i) + " of the population has the score " + std::to_string(scores[i]) + " instead of " + std::to_string(algorithm.check(chromosome)));
+			return;
+		}
+	}
+	
+	//The best chromosome is the best one ever evaluated (thanks to the elitism)
+	const SGA::Chromosome<unsigned> best = algorithm.best();
+	if (best.empty() || algorithm.bestScore() != algorithm.check(best) || algorithm.bestScore() != scores[0])
+		fail(test, "best() and bestScore() don't match the population");
+	if (algorithm.bestScore() != algorithm.record)
+		fail(test, "the best score is " + std::to_string(algorithm.bestScore()) + " but " + std::to_string(algorithm.record) + " was found");
+	
+	if (algorithm.getNumberOfEvaluations() != algorithm.evaluations)
+		fail(test, "getNumberOfEvaluations() is " + std::to_string(algorithm.getNumberOfEvaluations()) + " but score() was called " + std::to_string(algorithm.evaluations) + " times");
+}
+
+int main()
+{
+	//Budgets of evaluations which stop the evaluation in the middle of a generation
+	{
+		GA algorithm;
+		algorithm.setSeed(1);
+		algorithm.setBudgets(0.0, 0.0, 333);
+		check("333 evaluations", algorithm);
+		if (algorithm.evaluations != 333)
+			fail("333 evaluations", std::to_string(algorithm.evaluations) + " evaluations");
+	}
+	{
+		GA algorithm;
+		algorithm.setSeed(2);
+		algorithm.setParallelEvaluation(true, 3, 7);
+		algorithm.setFitnessCache(1000);
+		algorithm.setBudgets(0.0, 0.0, 1234);
+		check("1234 evaluations on 3 threads with the cache", algorithm);
+		if (algorithm.evaluations != 1234)
+			fail("1234 evaluations on 3 threads with the cache", std::to_string(algorithm.evaluations) + " evaluations");
+	}
+	{
+		GA algorithm;
+		algorithm.setSeed(3);
+		algorithm.setBudgets(0.0, 0.0, 40);
+		check("40 evaluations in the first generation", algorithm);
+		if (algorithm.evaluations != 40)
+			fail("40 evaluations in the first generation", std::to_string(algorithm.evaluations) + " evaluations");
+	}
+	
+	//Budgets of wall-clock time, in the first generation (100 chromosomes take 1 s) and later: the margin of 300 ms is for a busy machine
+	{
+		GA algorithm(10000);
+		algorithm.setBudgets(0.03);
+		check("30 ms in the first generation", algorithm, 330.0);
+	}
+	{
+		GA algorithm(10000);
+		algorithm.setParallelEvaluation(true, 4, 1);
+		algorithm.setBudgets(0.03);
+		check("30 ms in the first generation on 4 threads", algorithm, 330.0);
+	}
+	{
+		GA algorithm(200);
+		algorithm.setParallelEvaluation(true, 4);
+		algorithm.setBudgets(0.15);
+		check("150 ms on 4 threads", algorithm, 450.0);
+		if (algorithm.getNumberOfGenerations() == 0)
+			fail("150 ms on 4 threads", "the budget ended the first generation");
+	}
+	
+	//Large populations: a default chunk takes much longer than the margin (625 chromosomes of 5 ms serially, 156 per chunk on 4 threads), the deadline doesn't wait for it
+	{
+		GA algorithm(5000);
+		algorithm.setMainParameters(5000, 0.2);
+		algorithm.setBudgets(0.03);
+		check("30 ms in a large first generation", algorithm, 330.0);
+	}
+	{
+		GA algorithm(5000);
+		algorithm.setMainParameters(5000, 0.2);
+		algorithm.setParallelEvaluation(true, 4);
+		algorithm.setBudgets(0.03);
+		check("30 ms in a large first generation on 4 threads", algorithm, 330.0);
+	}
+	
+	//Budget of processor time, measured in processor time: a default chunk takes 125 ms of it (625 chromosomes of 200 us)
+	{
+		GA algorithm(200, true);
+		algorithm.setMainParameters(5000, 0.2);
+		algorithm.setBudgets(0.0, 0.03);
+		check("30 ms of processor time in a large first generation", algorithm, 60.0, true);
+	}
+	
+	//The budgets of time start after the creation of the first population, which takes longer than them here (2000 genes of 50 us)
+	{
+		GA algorithm;
+		algorithm.geneDelay = 50;
+		algorithm.setBudgets(0.01);
+		check("10 ms after a long creation of the first population", algorithm);
+	}
+	
+	//The size of the batches carries over to the next chunks and generations: the fast evaluations take about one batch per chunk (8 per generation)
+	{
+		GA algorithm;
+		algorithm.setMainParameters(1000, 0.2);
+		algorithm.setBudgets(0.2);
+		check("200 ms of fast evaluations", algorithm);
+		const unsigned long long chunks = 8 * (algorithm.getNumberOfGenerations() + 1);
+		if (algorithm.batches > 2 * chunks)
+			fail("200 ms of fast evaluations", std::to_string(algorithm.batches) + " batches for " + std::to_string(chunks) + " chunks");
+	}
+	
+	//Target score, and the steady state mode
+	{
+		GA algorithm;
+		algorithm.setSeed(4);
+		algorithm.setBudgets(0.0, 0.0, 0, 0, -850.0);
+		check("target score", algorithm);
+		if (algorithm.bestScore() < -850.0)
+			fail("target score", "stopped at " + std::to_string(algorithm.bestScore()));
+	}
+	{
+		GA algorithm;
+		algorithm.setSteadyState(true, 3);
+		algorithm.setBudgets(0.0, 0.0, 250);
+		check("250 evaluations in the steady state mode", algorithm);
+		if (algorithm.evaluations != 250)
+			fail("250 evaluations in the steady state mode", std::to_string(algorithm.evaluations) + " evaluations");
+	}
+	{
+		GA algorithm(1000);
+		algorithm.setSteadyState(true, 3);
+		algorithm.setBudgets(0.02);
+		check("20 ms in the first generation of the steady state mode", algorithm, 320.0);
+	}
+	{
+		GA algorithm;
+		algorithm.setMainParameters(0, 0.2);
+		algorithm.setSteadyState(true, 3);
+		bool refused = false;
+		try
+		{
+			algorithm.run(true);
+		}
+		catch (std::runtime_error const &)
+		{
+			refused = true;
+		}
+		if (!refused)
+			fail("empty population in the steady state mode", "not refused");
+	}
+	
+	std::cout << (failures ? "budgets: FAILED" : "budgets: ok") << std::endl;
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
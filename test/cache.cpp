@@ -0,0 +1,82 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: the fitness cache must evict with one clock hand per window, and an algorithm must evaluate each distinct chromosome
+ * of a population full of duplicates only once, the others being counted as hits.
+ */
+
+#include <iostream>
+#include <atomic>
+
+#include "../src/sga.hpp"
+#include "check.hpp"
+
+INIT_RANDOM();
+
+//Chromosomes of 3 genes in {0, 1}: only 8 different chromosomes
+class GA : public SGA::GeneticAlgorithm<unsigned>
+{
+	public :
+
+		mutable std::atomic<unsigned long long> evaluations;	//Number of calls to score()
+
+		GA() : SGA::GeneticAlgorithm<unsigned>(), evaluations(0) {}
+
+		virtual unsigned randomGene() const override
+		{
+			return SGA::Random::get(0u, 1u);
+		}
+
+		virtual SGA::Score score(SGA::Chromosome<unsigned> const & chromosome) const override
+		{
+			evaluations++;
+			return chromosome[0] + 2*chromosome[1] + 4*chromosome[2];
+		}
+};
+
+int main()
+{
+	//Two windows of 8 slots: the hashes 0 to 7 go into the first one, 8 to 15 (and 24) into the second one
+	SGA::FitnessCache cache;
+	cache.resize(16);
+	for (unsigned hash=0 ; hash<16 ; hash++)
+		cache.insert(hash, hash);
+
+	SGA::Score score = 0.0;
+	expect(cache.find(5, score) && score == 5.0, "a stored score is not found");
+
+	//Every entry has been used: the hand of each window clears them all and evicts its first slot
+	cache.insert(16, 16.0);
+	cache.insert(24, 24.0);
+	expect(!cache.find(0, score) && cache.find(16, score) && score == 16.0, "the first eviction of the first window is wrong");
+	expect(!cache.find(8, score) && cache.find(9, score) && cache.find(24, score), "the hand of the second window was moved by the first one");
+
+	//The hash 1 has been used since the last pass of the hand (second chance), the hash 2 hasn't
+	expect(cache.find(1, score), "the hash 1 was evicted too early");
+	cache.insert(17, 17.0);
+	expect(cache.find(1, score) && !cache.find(2, score) && cache.find(17, score), "a used entry didn't get its second chance");
+
+	//A population of 200 chromosomes with at most 8 different ones: the duplicates are taken from the cache
+	for (unsigned threads : {0u, 3u})
+	{
+		GA algorithm;
+		algorithm.setSeed(5);
+		algorithm.setMainParameters(200, 0.5);
+		algorithm.setChromosomesSize(3, 3);
+		algorithm.setEndingCriterion(SGA::EndingCriterion::NeverStop);
+		algorithm.setBudgets(0.0, 0.0, 0, 5);
+		algorithm.setFitnessCache(100);
+		if (threads > 0)
+			algorithm.setParallelEvaluation(true, threads);
+		algorithm.run(true);
+
+		const std::string mode = threads > 0 ? " (parallel)" : " (serial)";
+		expect(algorithm.getNumberOfCacheMisses() == algorithm.evaluations, "the cache misses don't match the evaluations" + mode);
+		expect(algorithm.evaluations <= 8, std::to_string(algorithm.evaluations) + " evaluations of 8 different chromosomes" + mode);
+		expect(algorithm.getNumberOfCacheHits() >= 192, "only " + std::to_string(algorithm.getNumberOfCacheHits()) + " cache hits" + mode);
+	}
+
+	return report("cache");
+}
@@ -0,0 +1,32 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+#pragma once
+
+//Checks shared by the regression tests (each test is a single source file including this header once)
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+//Number of failed checks
+unsigned failures = 0;
+
+//Print the message of a failed check and count it
+inline void expect(bool condition, std::string const & message)
+{
+	if (!condition)
+	{
+		std::cout << "FAILED: " << message << std::endl;
+		failures++;
+	}
+}
+
+//Print the result of the test and return the exit status of the program
+inline int report(std::string const & test)
+{
+	std::cout << test << (failures ? ": FAILED" : ": ok") << std::endl;
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: the migrants of an island model must arrive in the other islands, the budgets of an island must stop it
+ * in the middle of a generation, and islands in the steady state mode must be refused.
+ */
+
+#include <iostream>
+#include <stdexcept>
+
+#include "../src/sga.hpp"
+#include "check.hpp"
+
+INIT_RANDOM();
+
+//The genes of an island are drawn above its offset, and the small genes are the best: a chromosome of island 1 (offset 100)
+//with a score above -100 per gene must contain genes of island 0 (offset 0)
+class GA : public SGA::GeneticAlgorithm<unsigned, 10>
+{
+	public :
+
+		unsigned offset;
+
+		GA() : SGA::GeneticAlgorithm<unsigned, 10>(), offset(0)
+		{
+			setMainParameters(50, 0.2);
+			setElitism(1);
+		}
+
+		virtual unsigned randomGene() const override
+		{
+			return offset + SGA::Random::get(0u, 9u);
+		}
+
+		virtual SGA::Score score(ChromosomeType const & chromosome) const override
+		{
+			SGA::Score score = 0.0;
+			for (unsigned gene : chromosome)
+				score -= gene;
+			return score;
+		}
+};
+
+int main()
+{
+	//Ring of 2 islands migrating at each generation: island 0 runs until island 1 is over, and sends it its chromosomes meanwhile
+	{
+		SGA::IslandModel<GA> islands(2);
+		islands.setSeed(3);
+		islands.setMigration(SGA::MigrationTopology::Ring, 1, 2);
+		islands.island(0).setEndingCriterion(SGA::EndingCriterion::NeverStop);
+		islands.island(1).offset = 100;
+		islands.island(1).setEndingCriterion(SGA::EndingCriterion::NeverStop);
+		islands.island(1).setBudgets(0.0, 0.0, 0, 2000);
+		islands.run();
+
+		expect(islands.island(1).bestScore() > -1000.0, "no migrant of island 0 arrived in island 1 (best score " + std::to_string(islands.island(1).bestScore()) + ")");
+		expect(islands.bestScore() == islands.island(0).bestScore(), "the best score of the islands isn't the one of island 0");
+	}
+
+	//A budget of evaluations stops its island in the middle of its third generation, and then the other one
+	{
+		SGA::IslandModel<GA> islands(2);
+		islands.setSeed(4);
+		islands.setMigration(SGA::MigrationTopology::Ring, 1, 2);
+		for (unsigned i=0 ; i<2 ; i++)
+			islands.island(i).setEndingCriterion(SGA::EndingCriterion::NeverStop);
+		islands.island(0).setBudgets(0.0, 0.0, 120);
+		islands.run();
+
+		expect(islands.island(0).getNumberOfEvaluations() == 120, "island 0 evaluated " + std::to_string(islands.island(0).getNumberOfEvaluations()) + " chromosomes instead of 120");
+		expect(islands.island(0).getNumberOfGenerations() == 2, "island 0 stopped at generation " + std::to_string(islands.island(0).getNumberOfGenerations()));
+	}
+
+	//The steady state mode never comes back to migrate
+	{
+		SGA::IslandModel<GA> islands(2);
+		islands.island(1).setSteadyState(true, 2);
+		bool refused = false;
+		try
+		{
+			islands.run();
+		}
+		catch (std::runtime_error const &)
+		{
+			refused = true;
+		}
+		expect(refused, "an island in the steady state mode was accepted");
+	}
+
+	return report("islands");
+}
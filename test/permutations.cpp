@@ -0,0 +1,241 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: the permutation crossovers (PMX, OX, CX) and mutations (swap, insertion, inversion) must always give permutations,
+ * with the properties of each crossover, and an algorithm working on permutations must never evaluate anything else.
+ */
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <algorithm>
+
+#include "../src/sga.hpp"
+
+INIT_RANDOM();
+
+//Check that a chromosome holds each integer from 0 to its size-1 exactly once
+template <typename Genes>
+bool isPermutation(Genes const & chromosome)
+{
+	std::vector<bool> seen(chromosome.size(), false);
+	for (unsigned i=0 ; i<chromosome.size() ; i++)
+	{
+		const std::size_t gene = chromosome[i];
+		if (gene >= chromosome.size() || seen[gene])
+			return false;
+		seen[gene] = true;
+	}
+	return true;
+}
+
+//Textbook PMX: the child takes the segment of the other parent, the other genes of its parent are mapped through the segment until they don't conflict
+std::vector<int> referencePartiallyMapped(std::vector<int> const & parent, std::vector<int> const & other, unsigned begin, unsigned end)
+{
+	std::vector<int> child(parent.size());
+	std::vector<bool> inSegment(parent.size(), false);
+	for (unsigned i=begin ; i<=end ; i++)
+	{
+		child[i] = other[i];
+		inSegment[other[i]] = true;
+	}
+	
+	for (unsigned i=0 ; i<parent.size() ; i++)
+	{
+		if (i >= begin && i <= end)
+			continue;
+		
+		int gene = parent[i];
+		while (inSegment[gene])
+			gene = parent[std::find(other.begin(), other.end(), gene) - other.begin()];
+		child[i] = gene;
+	}
+	return child;
+}
+
+//Sum of the distances between consecutive genes, to be maximized (any score works, the test only looks at the chromosomes)
+template <typename Genes>
+SGA::Score tourScore(Genes const & chromosome)
+{
+	SGA::Score score = 0.0;
+	for (unsigned i=0 ; i+1<chromosome.size() ; i++)
+		score -= std::abs((int)chromosome[i] - (int)chromosome[i+1]);
+	return score;
+}
+
+//Permutations of fixed size known at compile time
+class StaticTour : public SGA::StaticGeneticAlgorithm<StaticTour, unsigned, 40>
+{
+	public :
+	
+		mutable std::atomic<unsigned> invalid;
+		
+		StaticTour() : SGA::StaticGeneticAlgorithm<StaticTour, unsigned, 40>(), invalid(0) {}
+		
+		unsigned randomGene() const
+		{
+			return 0;
+		}
+		
+		SGA::Score score(ChromosomeType const & chromosome) const
+		{
+			if (!isPermutation(chromosome))
+				invalid++;
+			return tourScore(chromosome);
+		}
+};
+
+//Permutations of fixed size set at run time
+class Tour : public SGA::GeneticAlgorithm<int>
+{
+	public :
+	
+		mutable std::atomic<unsigned> invalid;
+		
+		Tour() : SGA::GeneticAlgorithm<int>(), invalid(0) {}
+		
+		virtual int randomGene() const override
+		{
+			return 0;
+		}
+		
+		virtual SGA::Score score(SGA::Chromosome<int> const & chromosome) const override
+		{
+			if (!isPermutation(chromosome))
+				invalid++;
+			return tourScore(chromosome);
+		}
+};
+
+int main()
+{
+	unsigned failures = 0;
+	const char * crossovers[] = {"PMX", "OX", "CX"};
+	const char * mutations[] = {"swap", "insertion", "inversion"};
+	
+	//The operators on their own, on random parents of every size from 1 to 40
+	SGA::RandomStream random(11);
+	unsigned invalidChildren[3] = {0, 0, 0};
+	unsigned wrongChildren[3] = {0, 0, 0};
+	unsigned invalidMutants = 0;
+	for (unsigned test=0 ; test<3000 ; test++)
+	{
+		const unsigned size = 1 + test % 40;
+		std::vector<int> first(size), second(size);
+		SGA::randomPermutation(first, size, random);
+		SGA::randomPermutation(second, size, random);
+		
+		for (unsigned type=0 ; type<3 ; type++)
+		{
+			//The children start as copies of their parents, like in the algorithm
+			std::vector<int> firstChild = first, secondChild = second;
+			SGA::RandomStream segment = random;
+			if (type == 0)
+				SGA::partiallyMappedCrossover(first, second, firstChild, secondChild, size, random);
+			else if (type == 1)
+				SGA::orderCrossover(first, second, firstChild, secondChild, size, random);
+			else
+				SGA::cycleCrossover(first, second, firstChild, secondChild, size, random);
+			
+			if (!isPermutation(firstChild) || !isPermutation(secondChild))
+			{
+				invalidChildren[type]++;
+				continue;
+			}
+			
+			//PMX: same children as the textbook version, on the same segment
+			//OX: each child keeps the segment of its parent
+			//CX: each gene comes from one of the parents at the same position, and the two children take the other one (the first cycle is kept)
+			unsigned begin = 0, end = 0;
+			if (size >= 2)
+				SGA::randomSegment(size, segment, begin, end);
+			
+			bool right = true;
+			if (type == 0 && size >= 2)
+				right = firstChild == referencePartiallyMapped(first, second, begin, end) && secondChild == referencePartiallyMapped(second, first, begin, end);
+			if (type == 2)
+				right = firstChild[0] == first[0];
+			for (unsigned i=0 ; i<size ; i++)
+			{
+				if (type == 1 && size >= 2 && i >= begin && i <= end)
+					right = right && firstChild[i] == first[i] && secondChild[i] == second[i];
+				if (type == 2)
+					right = right && ((firstChild[i] == first[i] && secondChild[i] == second[i]) || (firstChild[i] == second[i] && secondChild[i] == first[i]));
+			}
+			if (!right)
+				wrongChildren[type]++;
+		}
+		
+		std::vector<int> mutant = first;
+		SGA::swapMutation(mutant, random);
+		SGA::insertionMutation(mutant, random);
+		SGA::inversionMutation(mutant, random);
+		if (!isPermutation(mutant))
+			invalidMutants++;
+	}
+	
+	for (unsigned type=0 ; type<3 ; type++)
+	{
+		if (invalidChildren[type] || wrongChildren[type])
+		{
+			std::cout << "FAILED: " << crossovers[type] << " gave " << invalidChildren[type] << " invalid and " << wrongChildren[type] << " wrong children" << std::endl;
+			failures++;
+		}
+	}
+	if (invalidMutants)
+	{
+		std::cout << "FAILED: the mutations gave " << invalidMutants << " invalid chromosomes" << std::endl;
+		failures++;
+	}
+	
+	//Every crossover with every mutation in the algorithm, generational (std::array and std::vector) and steady state
+	for (unsigned crossover=0 ; crossover<3 ; crossover++)
+	{
+		for (unsigned mutation=0 ; mutation<3 ; mutation++)
+		{
+			const SGA::CrossoverType crossoverType[] = {SGA::CrossoverType::PartiallyMapped, SGA::CrossoverType::Ordered, SGA::CrossoverType::Cycle};
+			const SGA::MutationType mutationType[] = {SGA::MutationType::Swap, SGA::MutationType::Insertion, SGA::MutationType::Inversion};
+			
+			try
+			{
+				StaticTour fixed;
+				fixed.setSeed(crossover*3 + mutation);
+				fixed.setPermutations(true);
+				fixed.setCrossoverType(crossoverType[crossover]);
+				fixed.setMutationType(mutationType[mutation]);
+				fixed.setMainParameters(100, 0.5);
+				fixed.setElitism(2);
+				fixed.setEndingCriterion(SGA::EndingCriterion::BestScore, 0.0, 30);
+				fixed.run(true);
+				
+				Tour steady;
+				steady.setSeed(crossover*3 + mutation);
+				steady.setChromosomesSize(30, 30);
+				steady.setPermutations(true);
+				steady.setCrossoverType(crossoverType[crossover]);
+				steady.setMutationType(mutationType[mutation]);
+				steady.setMainParameters(100, 0.5);
+				steady.setSteadyState(true, 3);
+				steady.setEndingCriterion(SGA::EndingCriterion::BestScore, 0.0, 30);
+				steady.run(true);
+				
+				if (fixed.invalid || !isPermutation(fixed.best()) || steady.invalid || !isPermutation(steady.best()))
+				{
+					std::cout << "FAILED: " << crossovers[crossover] << " with the " << mutations[mutation] << " mutation evaluated " << fixed.invalid + steady.invalid << " invalid chromosomes" << std::endl;
+					failures++;
+				}
+			}
+			catch (std::exception & error)
+			{
+				std::cout << "FAILED: " << crossovers[crossover] << " with the " << mutations[mutation] << " mutation threw: " << error.what() << std::endl;
+				failures++;
+			}
+		}
+	}
+	
+	std::cout << (failures ? "permutations: FAILED" : "permutations: ok") << std::endl;
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,220 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: islands in separate processes must exchange their migrants and agree on the best score, even after a crashed
+ * island left its segments behind, the last island must remove the segments, and the bit chromosomes must cross the queues.
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include <csignal>
+#include <sys/wait.h>
+
+#include "../src/sga_shm.hpp"
+#include "check.hpp"
+
+INIT_RANDOM();
+
+//Same algorithm as the islands test: a chromosome of island 1 with a score above -1000 contains genes of island 0
+class GA : public SGA::GeneticAlgorithm<unsigned, 10>
+{
+	public :
+
+		unsigned offset;
+
+		GA() : SGA::GeneticAlgorithm<unsigned, 10>(), offset(0)
+		{
+			setMainParameters(50, 0.2);
+			setElitism(1);
+			setEndingCriterion(SGA::EndingCriterion::NeverStop);
+		}
+
+		virtual unsigned randomGene() const override
+		{
+			return offset + SGA::Random::get(0u, 9u);
+		}
+
+		virtual SGA::Score score(ChromosomeType const & chromosome) const override
+		{
+			SGA::Score score = 0.0;
+			for (unsigned gene : chromosome)
+				score -= gene;
+			return score;
+		}
+};
+
+bool exists(std::string const & name)
+{
+	const int descriptor = shm_open(name.c_str(), O_RDWR, 0);
+	if (descriptor < 0)
+		return false;
+	close(descriptor);
+	return true;
+}
+
+//Scores reported by an island once both islands are over
+struct Report
+{
+	SGA::Score shared;	//bestScore() of the islands
+	SGA::Score local;	//Best score of the island itself
+};
+
+//Child process: run the island, tell the parent, wait for its go to read the scores (the other island is over by then) and report them
+void island(std::string const & name, unsigned index, int done, int go, int report)
+{
+	int status = EXIT_SUCCESS;
+	try
+	{
+		SGA::ProcessIsland<GA> island(name, index, 2);
+		island.setMigration(SGA::MigrationTopology::Ring, 1, 2);
+		if (index == 1)
+		{
+			island.island().offset = 100;
+			island.island().setBudgets(0.0, 0.0, 0, 2000);
+		}
+		island.run();
+
+		char byte = 0;
+		if (write(done, &byte, 1) != 1 || read(go, &byte, 1) != 1)
+			throw std::runtime_error("Broken pipe");
+
+		const Report scores = {island.bestScore(), island.island().bestScore()};
+		if (write(report, &scores, sizeof(scores)) != sizeof(scores))
+			throw std::runtime_error("Broken pipe");
+	}
+	catch (std::exception const & error)
+	{
+		std::cout << "FAILED: island " << index << ": " << error.what() << std::endl;
+		status = EXIT_FAILURE;
+	}
+
+	std::cout.flush();
+	_exit(status);
+}
+
+int main()
+{
+	const std::string name = "/sga-processes-" + std::to_string(getpid());
+	const std::string segments[] = {name + "-control", name + "-0-1", name + "-1-0"};
+
+	//A crashed island: killed while waiting for the other one, it leaves its process id and its arrival in the segments
+	const pid_t crashed = fork();
+	if (crashed == 0)
+	{
+		SGA::ProcessIsland<GA> island(name, 0, 2);
+		island.run();
+		_exit(EXIT_SUCCESS);
+	}
+	usleep(200000);
+	kill(crashed, SIGKILL);
+	waitpid(crashed, nullptr, 0);
+	expect(exists(segments[0]), "the crashed island left no segment to test with");
+
+	//Two islands of a new session: island 0 sends its chromosomes to island 1 until island 1 is over
+	int done[2], go[2], scores[2];
+	if (pipe(done) < 0 || pipe(go) < 0 || pipe(scores) < 0)
+		throw std::runtime_error("Cannot create the pipes");
+
+	pid_t children[2];
+	for (unsigned i=0 ; i<2 ; i++)
+	{
+		children[i] = fork();
+		if (children[i] == 0)
+			island(name, i, done[1], go[0], scores[1]);
+	}
+
+	char bytes[2] = {0, 0};
+	bool over = read(done[0], bytes, 1) == 1 && read(done[0], bytes, 1) == 1;
+	over = over && write(go[1], bytes, 2) == 2;
+
+	Report reports[2];
+	for (unsigned i=0 ; over && i<2 ; i++)
+		over = read(scores[0], &reports[i], sizeof(Report)) == sizeof(Report);
+
+	bool succeeded = true;
+	for (unsigned i=0 ; i<2 ; i++)
+	{
+		int status = 0;
+		waitpid(children[i], &status, 0);
+		succeeded = succeeded && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+	}
+
+	expect(over && succeeded, "the islands didn't run to their end");
+	if (over && succeeded)
+	{
+		//The reports come in any order: island 1 has the worst best score
+		const SGA::Score best = std::max(reports[0].local, reports[1].local);
+		const SGA::Score worst = std::min(reports[0].local, reports[1].local);
+		expect(reports[0].shared == reports[1].shared, "the islands disagree on the best score (" + std::to_string(reports[0].shared) + " and " + std::to_string(reports[1].shared) + ")");
+		expect(reports[0].shared == best, "the best score of the islands isn't the best one of an island");
+		expect(worst > -1000.0, "no migrant of island 0 arrived in island 1 (best score " + std::to_string(worst) + ")");
+	}
+
+	for (std::string const & segment : segments)
+		expect(!exists(segment), "the segment " + segment + " was not removed by the last island");
+
+	//An island index can't be used twice in the same session, and the last island removes the segments
+	{
+		SGA::ProcessIsland<GA> first(name, 0, 2);
+		bool refused = false;
+		try
+		{
+			SGA::ProcessIsland<GA> twice(name, 0, 2);
+		}
+		catch (std::runtime_error const &)
+		{
+			refused = true;
+		}
+		expect(refused, "the same island was attached twice");
+		SGA::ProcessIsland<GA> second(name, 1, 2);
+	}
+	expect(!exists(segments[0]), "the control segment was not removed by the last island");
+
+	//An island alone gives up waiting for the other one after its timeout, and removes the segments all the same
+	{
+		SGA::ProcessIsland<GA> alone(name, 0, 2);
+		alone.setStartTimeout(0.2);
+		bool timedOut = false;
+		try
+		{
+			alone.run();
+		}
+		catch (std::runtime_error const & error)
+		{
+			timedOut = std::string(error.what()).find("1 (not started)") != std::string::npos;
+		}
+		expect(timedOut, "an island waited for an island which never started without reporting it");
+	}
+	for (std::string const & segment : segments)
+		expect(!exists(segment), "the segment " + segment + " was not removed after the timeout");
+	
+	//Bit chromosomes are copied word by word, and a queue left by another session is emptied
+	{
+		SGA::SharedMemoryQueue<SGA::Bit> queue(name + "-bits", 2, 130, 1);
+		SGA::BitChromosome<0> sent(130);
+		for (unsigned i=0 ; i<130 ; i+=3)
+			sent[i] = true;
+		sent[129] = true;
+		expect(queue.push(sent, 42.0), "a bit chromosome can't be pushed");
+
+		SGA::BitChromosome<0> received(5);
+		SGA::Score score = 0.0;
+		expect(queue.pop(received, score) && received == sent && received.count() == sent.count() && score == 42.0, "the bit chromosome changed in the queue");
+
+		SGA::SharedMemoryQueue<SGA::Bit, 70> fixed(name + "-fixed-bits", 2, 70, 1);
+		SGA::BitChromosome<70> bits, copy;
+		bits[0] = bits[63] = bits[64] = bits[69] = true;
+		expect(fixed.push(bits, 1.0) && fixed.pop(copy, score) && copy == bits, "the fixed bit chromosome changed in the queue");
+
+		expect(queue.push(sent, 1.0), "a bit chromosome can't be pushed");
+		SGA::SharedMemoryQueue<SGA::Bit> stale(name + "-bits", 2, 130, 2);
+		expect(!stale.pop(received, score), "the queue of another session was not emptied");
+
+		queue.unlink();
+		fixed.unlink();
+	}
+
+	return report("processes");
+}
@@ -0,0 +1,242 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: a seeded run must give exactly the same generations whatever the number of threads evaluating them,
+ * the size of their chunks and the fitness cache, a run must be replayable from the seed it reports, and it must not change the numbers
+ * the user draws from SGA::Random. The bulk draws of the generators must give the same numbers as the draws one at a time.
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../src/sga.hpp"
+
+INIT_RANDOM();
+
+class GA : public SGA::GeneticAlgorithm<unsigned>
+{
+	public :
+	
+		GA() : SGA::GeneticAlgorithm<unsigned>() {}
+	
+		virtual unsigned randomGene() const override
+		{
+			return SGA::Random::get(0u, 9u);
+		}
+		
+		virtual SGA::Score score(SGA::Chromosome<unsigned> const & chromosome) const override
+		{
+			SGA::Score score = 0.0;
+			for (unsigned gene : chromosome)
+				score += gene * (gene % 3);
+			return score - chromosome.size();
+		}
+};
+
+//The outcome of a run
+struct Result
+{
+	unsigned generations;
+	SGA::RaggedPopulation<unsigned> population;
+	std::vector<SGA::Score> scores;
+	
+	bool operator==(Result const & other) const
+	{
+		return generations == other.generations && population.allGenes() == other.population.allGenes() && population.offsets() == other.population.offsets() && scores == other.scores;
+	}
+};
+
+Result run(GA & algorithm)
+{
+	Result result;
+	algorithm.run(true);
+	result.generations = algorithm.getNumberOfGenerations();
+	algorithm.getPopulation(result.population, result.scores);
+	return result;
+}
+
+void setParameters(GA & algorithm)
+{
+	algorithm.setMainParameters(301, 0.3);
+	algorithm.setChromosomesSize(10, 80);
+	algorithm.setEndingCriterion(SGA::EndingCriterion::BestScore, 0.0, 20);
+	algorithm.setElitism(2);
+}
+
+//Two generators at the same position, after skip numbers of 32 bits (which leaves a partial block in a RandomStream)
+template <typename Generator>
+void twins(Generator & first, Generator & second, unsigned skip)
+{
+	first = Generator(7);
+	second = Generator(7);
+	for (unsigned i=0 ; i<skip ; i++)
+	{
+		first.next32();
+		second.next32();
+	}
+}
+
+//Compare the bulk draws of a generator with count draws one at a time, and check that both generators end at the same position
+template <typename Generator>
+unsigned compareDraws(std::string const & name)
+{
+	unsigned failures = 0;
+	auto check = [&](bool same, std::string const & draw, unsigned skip, unsigned count)
+	{
+		if (!same)
+		{
+			std::cout << "FAILED: " << name << ": " << draw << " of " << count << " numbers after " << skip << " differs from the draws one at a time" << std::endl;
+			failures++;
+		}
+	};
+	
+	const unsigned counts[] = {0, 1, 2, 3, 4, 5, 63, 64, 65, 127, 128, 129, 300};
+	const std::uint32_t bounds[] = {0, 1, 3, 1000, 0x80000001u, 0xFFFFFFFFu};
+	Generator bulk, single;
+	std::vector<std::uint32_t> numbers32(300);
+	std::vector<std::uint64_t> numbers64(300);
+	std::vector<double> units(300);
+	std::vector<float> floats(300);
+	
+	for (unsigned skip : {0u, 1u, 3u, 6u})
+	{
+		for (unsigned count : counts)
+		{
+			bool same = true;
+			twins(bulk, single, skip);
+			bulk.fill(numbers32.data(), count);
+			for (unsigned i=0 ; i<count ; i++)
+				same = same && numbers32[i] == single.next32();
+			check(same && bulk.next32() == single.next32(), "fill() of 32 bits", skip, count);
+			
+			same = true;
+			twins(bulk, single, skip);
+			bulk.fill(numbers64.data(), count);
+			for (unsigned i=0 ; i<count ; i++)
+				same = same && numbers64[i] == single();
+			check(same && bulk.next32() == single.next32(), "fill() of 64 bits", skip, count);
+			
+			//The rejections of the bounds which don't divide 2^32 take more random bits than numbers
+			for (std::uint32_t bound : bounds)
+			{
+				same = true;
+				twins(bulk, single, skip);
+				bulk.below(bound, numbers32.data(), count);
+				for (unsigned i=0 ; i<count ; i++)
+					same = same && numbers32[i] == single.below(bound);
+				check(same && bulk.next32() == single.next32(), "below(" + std::to_string(bound) + ")", skip, count);
+			}
+			
+			same = true;
+			twins(bulk, single, skip);
+			bulk.unit(units.data(), count);
+			for (unsigned i=0 ; i<count ; i++)
+				same = same && units[i] == single.unit();
+			check(same && bulk.next32() == single.next32(), "unit() of doubles", skip, count);
+			
+			same = true;
+			twins(bulk, single, skip);
+			bulk.unit(floats.data(), count);
+			for (unsigned i=0 ; i<count ; i++)
+				same = same && floats[i] == static_cast<float>(single.unit());
+			check(same && bulk.next32() == single.next32(), "unit() of floats", skip, count);
+			
+			//Box-Muller on pairs of unit(), the last pair is drawn whole when count is odd
+			same = true;
+			twins(bulk, single, skip);
+			bulk.normal(units.data(), count);
+			for (unsigned i=0 ; i<count ; i+=2)
+			{
+				const double radius = std::sqrt(-2.0 * std::log(1.0 - single.unit()));
+				const double angle = 6.283185307179586 * single.unit();
+				same = same && units[i] == radius * std::cos(angle) && (i+1 == count || units[i+1] == radius * std::sin(angle));
+			}
+			check(same && bulk.next32() == single.next32(), "normal()", skip, count);
+		}
+	}
+	
+	return failures;
+}
+
+int main()
+{
+	unsigned failures = 0;
+	
+	//The bulk draws give the same numbers as the draws one at a time
+	failures += compareDraws<SGA::RandomStream>("RandomStream");
+	failures += compareDraws<SGA::Xoshiro256>("Xoshiro256");
+	
+	//Same seed, any number of threads, any chunk size, with or without the cache
+	GA reference;
+	setParameters(reference);
+	reference.setSeed(1234);
+	const Result expected = run(reference);
+	
+	const unsigned threads[] = {1, 2, 7, 1, 3};
+	const unsigned chunks[] = {0, 0, 0, 1, 17};
+	for (unsigned i=0 ; i<5 ; i++)
+	{
+		for (unsigned cache : {0u, 1000u})
+		{
+			GA algorithm;
+			setParameters(algorithm);
+			algorithm.setSeed(1234);
+			algorithm.setParallelEvaluation(true, threads[i], chunks[i]);
+			algorithm.setFitnessCache(cache);
+			if (!(run(algorithm) == expected))
+			{
+				std::cout << "FAILED: " << threads[i] << " thread(s), chunks of " << chunks[i] << ", cache of " << cache << " give another run" << std::endl;
+				failures++;
+			}
+		}
+	}
+	
+	//Replay of an unseeded run
+	GA first;
+	setParameters(first);
+	const Result original = run(first);
+	GA second;
+	setParameters(second);
+	second.setSeed(first.getSeed());
+	second.setParallelEvaluation(true, 3);
+	if (!(run(second) == original))
+	{
+		std::cout << "FAILED: the seed of a run doesn't replay it" << std::endl;
+		failures++;
+	}
+	
+	//Running the same object again gives the same run
+	if (!(run(reference) == expected))
+	{
+		std::cout << "FAILED: a second run of the same algorithm differs" << std::endl;
+		failures++;
+	}
+	
+	//A run leaves the generator of the user's thread where it was
+	SGA::Random::seed(42);
+	const unsigned long long before[2] = {SGA::Random::engine()(), SGA::Random::engine()()};
+	SGA::Random::seed(42);
+	SGA::Random::engine()();
+	run(reference);
+	if (SGA::Random::engine()() != before[1])
+	{
+		std::cout << "FAILED: a run changes the numbers drawn from SGA::Random by the user" << std::endl;
+		failures++;
+	}
+	
+	//The floats are below their maximum even when the rounding goes up (the floats around 1e8 are 8 apart)
+	for (unsigned i=0 ; i<1000 ; i++)
+	{
+		if (SGA::Random::get(1e8f, 1e8f + 8.0f) >= 1e8f + 8.0f || SGA::Random::get(0.0, 1.0) >= 1.0)
+		{
+			std::cout << "FAILED: SGA::Random::get() reached its maximum" << std::endl;
+			failures++;
+			break;
+		}
+	}
+	
+	std::cout << (failures ? "reproducibility: FAILED" : "reproducibility: ok") << std::endl;
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
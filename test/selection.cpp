@@ -0,0 +1,105 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: the fitness proportionate selections must never pick a chromosome counting as 0 when some scores are positive,
+ * and must pick uniformly (and return) when no score is positive.
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../src/sga.hpp"
+#include "check.hpp"
+
+INIT_RANDOM();
+
+//Score of a chromosome of one gene: the gene plus an offset (all negative with an offset of -1000)
+class Selector : public SGA::StaticGeneticAlgorithm<Selector, int>
+{
+	public :
+
+		SGA::Score offset;
+
+		Selector(SGA::Score scoreOffset) : offset(scoreOffset)
+		{
+			setMainParameters(100, 0.1);
+			setChromosomesSize(1, 1);
+			setEndingCriterion(SGA::EndingCriterion::NeverStop);
+			setBudgets(0.0, 0.0, 0, 3);
+		}
+
+		int randomGene() const
+		{
+			return SGA::Random::get(0, 99);
+		}
+
+		SGA::Score score(ChromosomeType const & chromosome) const
+		{
+			return chromosome[0] + offset;
+		}
+
+		//Select many chromosomes from the last generation and count how many times each one was picked
+		std::vector<unsigned> histogram(SGA::SelectionType type, unsigned draws)
+		{
+			_selectionType = type;
+			std::vector<unsigned> counts(_population.size(), 0);
+			std::vector<unsigned> selection;
+			for (unsigned i=0 ; selection.size()<draws ; i++)
+			{
+				useRandomStream(_generation, i, SGA::GeneticOperator::Selection);
+				select(selection);
+			}
+			for (unsigned index : selection)
+				counts.at(index)++;
+			return counts;
+		}
+
+		SGA::Score scoreOf(unsigned index) const
+		{
+			return _scores[index];
+		}
+};
+
+int main()
+{
+	char const * names[] = {"roulette wheel", "stochastic universal sampling"};
+	const SGA::SelectionType types[] = {SGA::SelectionType::RouletteWheel, SGA::SelectionType::StochasticUniversal};
+
+	for (unsigned t=0 ; t<2 ; t++)
+	{
+		//All the scores are negative: every chromosome can be picked, the worst one no more than the others
+		Selector negative(-1000.0);
+		negative.setSelectionType(types[t]);
+		negative.run(true);
+
+		const std::vector<unsigned> uniform = negative.histogram(types[t], 10000);
+		unsigned picked = 0;
+		unsigned most = 0;
+		for (unsigned count : uniform)
+		{
+			picked += count > 0;
+			most = std::max(most, count);
+		}
+		expect(picked >= 90, std::string(names[t]) + " picked " + std::to_string(picked) + " different chromosomes out of 100 with negative scores");
+		expect(most < 300, std::string(names[t]) + " picked a chromosome " + std::to_string(most) + " times out of 10000 with negative scores");
+
+		//Half of the scores are negative: they are never picked
+		Selector mixed(-50.0);
+		mixed.setSelectionType(types[t]);
+		mixed.run(true);
+
+		const std::vector<unsigned> proportionate = mixed.histogram(types[t], 10000);
+		for (unsigned i=0 ; i<proportionate.size() ; i++)
+		{
+			if (mixed.scoreOf(i) <= 0.0 && proportionate[i] > 0)
+			{
+				expect(false, std::string(names[t]) + " picked a chromosome of score " + std::to_string(mixed.scoreOf(i)));
+				break;
+			}
+		}
+	}
+
+	return report("selection");
+}
@@ -0,0 +1,187 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: the kernels of the real-valued operators (blend crossover, Gaussian mutation, bounds) must give the same genes,
+ * bit for bit, and report the same changes with every instruction set the processor supports, whatever the number of genes.
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <limits>
+#include <cmath>
+
+#include "../src/sga.hpp"
+
+INIT_RANDOM();
+
+//Run a kernel with an instruction set on copies of the arrays, returns false if the processor doesn't support it
+template <typename T, typename Kernel>
+bool runKernel(SGA::InstructionSet instructionSet, Kernel const & kernel, std::vector<std::vector<T> > & arrays, bool & changed)
+{
+	T * pointers[Kernel::numberOfArrays];
+	for (unsigned a=0 ; a<Kernel::numberOfArrays ; a++)
+		pointers[a] = arrays[a].data();
+	const unsigned size = arrays[0].size();
+	
+	if (instructionSet == SGA::InstructionSet::Scalar)
+	{
+		changed = SGA::runScalarKernel(kernel, pointers, size);
+		return true;
+	}
+	
+	#ifdef SGA_SIMD_DISPATCH
+	__builtin_cpu_init();
+	if (instructionSet == SGA::InstructionSet::AVX2 && __builtin_cpu_supports("avx2"))
+	{
+		changed = SGA::runAVX2Kernel(kernel, pointers, size);
+		return true;
+	}
+	if (instructionSet == SGA::InstructionSet::AVX512 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+	{
+		changed = SGA::runAVX512Kernel(kernel, pointers, size);
+		return true;
+	}
+	#endif
+	
+	return false;
+}
+
+//Compare a kernel on every supported instruction set with the scalar one, returns the number of mismatches
+template <typename T, typename Kernel>
+unsigned compareKernel(char const * name, Kernel const & kernel, std::vector<std::vector<T> > const & arrays)
+{
+	std::vector<std::vector<T> > expected = arrays;
+	bool expectedChanged = false;
+	runKernel(SGA::InstructionSet::Scalar, kernel, expected, expectedChanged);
+	
+	unsigned mismatches = 0;
+	const SGA::InstructionSet instructionSets[] = {SGA::InstructionSet::AVX2, SGA::InstructionSet::AVX512};
+	for (SGA::InstructionSet instructionSet : instructionSets)
+	{
+		std::vector<std::vector<T> > result = arrays;
+		bool changed = false;
+		if (!runKernel(instructionSet, kernel, result, changed))
+			continue;
+		
+		bool same = changed == expectedChanged;
+		for (unsigned a=0 ; a<arrays.size() ; a++)
+			same = same && (arrays[a].empty() || std::memcmp(result[a].data(), expected[a].data(), arrays[a].size() * sizeof(T)) == 0);
+		
+		if (!same)
+		{
+			std::cout << "FAILED: " << name << " on " << arrays[0].size() << " " << (sizeof(T) == sizeof(float) ? "float" : "double") << " genes with " << (instructionSet == SGA::InstructionSet::AVX2 ? "AVX2" : "AVX-512") << " (changes " << changed << " instead of " << expectedChanged << ")" << std::endl;
+			mismatches++;
+		}
+	}
+	
+	return mismatches;
+}
+
+//Genes between 1 and 2, some of them out of these bounds if asked, with a few signed zeros and NaN
+template <typename T>
+std::vector<T> randomGenes(SGA::Xoshiro256 & random, unsigned size, bool outOfBounds, bool special)
+{
+	std::vector<T> genes(size);
+	for (unsigned i=0 ; i<size ; i++)
+	{
+		genes[i] = static_cast<T>(random.uniform(1.0, 2.0));
+		if (outOfBounds && random.below(4) == 0)
+			genes[i] = static_cast<T>(random.uniform(-3.0, 5.0));
+		if (special && random.below(8) == 0)
+		{
+			const T values[] = {T(0.0), T(-0.0), std::numeric_limits<T>::quiet_NaN()};
+			genes[i] = values[random.below(3)];
+		}
+	}
+	return genes;
+}
+
+template <typename T>
+std::vector<T> uniforms(SGA::Xoshiro256 & random, unsigned size)
+{
+	std::vector<T> numbers(size);
+	for (unsigned i=0 ; i<size ; i++)
+		numbers[i] = static_cast<T>(random.unit());
+	return numbers;
+}
+
+template <typename T>
+unsigned compareKernels()
+{
+	unsigned mismatches = 0;
+	SGA::Xoshiro256 random(sizeof(T));
+	
+	//Every size up to a few full vectors (all the lengths of the last genes), then a long chromosome
+	for (unsigned size=0 ; size<=70 ; size++)
+	{
+		for (unsigned data=0 ; data<3 ; data++)
+		{
+			const unsigned length = size == 70 ? 1001 : size;
+			const bool outOfBounds = data > 0;
+			const bool special = data > 1;
+			
+			const SGA::ClampKernel<T> clamp = {T(1.0), T(2.0)};
+			std::vector<std::vector<T> > genes(1, randomGenes<T>(random, length, outOfBounds, special));
+			mismatches += compareKernel("the bounds", clamp, genes);
+			
+			//No noise at all, then some noise
+			const SGA::PerturbKernel<T> still = {T(0.0), T(1.0), T(2.0)};
+			const SGA::PerturbKernel<T> noise = {T(0.3), T(1.0), T(2.0)};
+			std::vector<std::vector<T> > perturbed(1, randomGenes<T>(random, length, outOfBounds, special));
+			perturbed.push_back(randomGenes<T>(random, length, true, false));
+			mismatches += compareKernel("the Gaussian mutation without noise", still, perturbed);
+			mismatches += compareKernel("the Gaussian mutation", noise, perturbed);
+			
+			//Different parents, then identical parents and no enlargement
+			const SGA::BlendKernel<T> blend = {T(0.5), T(1.0), T(2.0)};
+			const SGA::BlendKernel<T> exact = {T(0.0), T(1.0), T(2.0)};
+			std::vector<std::vector<T> > parents(1, randomGenes<T>(random, length, outOfBounds, special));
+			parents.push_back(randomGenes<T>(random, length, outOfBounds, special));
+			parents.push_back(uniforms<T>(random, length));
+			parents.push_back(uniforms<T>(random, length));
+			mismatches += compareKernel("the blend crossover", blend, parents);
+			parents[1] = parents[0];
+			mismatches += compareKernel("the blend crossover of identical parents", exact, parents);
+		}
+	}
+	
+	return mismatches;
+}
+
+int main()
+{
+	unsigned failures = compareKernels<float>() + compareKernels<double>();
+	
+	//The operators with the instruction set of this processor: genes within the bounds are not changes
+	std::vector<double> genes = {1.5, 1.25, 1.75};
+	if (SGA::clampGenes(genes, genes.size(), 1.0, 2.0))
+	{
+		std::cout << "FAILED: the bounds changed genes which were already within them" << std::endl;
+		failures++;
+	}
+	
+	SGA::RandomStream random(7);
+	std::vector<float> mutant = {1.5f, 1.25f, 1.75f, 1.0f, 2.0f};
+	if (SGA::gaussianMutation(mutant, 0.0, random, 1.0, 2.0))
+	{
+		std::cout << "FAILED: the Gaussian mutation without noise changed genes" << std::endl;
+		failures++;
+	}
+	
+	//A NaN gene stays NaN, with the bounds and without them (the simulated binary crossover doesn't clamp without bounds)
+	std::vector<double> nan = {std::numeric_limits<double>::quiet_NaN(), 1.5};
+	SGA::clampGenes(nan, nan.size(), 1.0, 2.0);
+	std::vector<double> first = {std::numeric_limits<double>::quiet_NaN(), 1.0}, second = {1.0, 3.0};
+	SGA::simulatedBinaryCrossover(first, second, first.size(), 2.0, random);
+	if (!std::isnan(nan[0]) || !std::isnan(first[0]) || !std::isnan(second[0]))
+	{
+		std::cout << "FAILED: a NaN gene was replaced by a number" << std::endl;
+		failures++;
+	}
+	
+	std::cout << (failures ? "simd: FAILED" : "simd: ok") << std::endl;
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+// Copyright © 2015 Pierre Schefler <schefler.pierre@gmail.com>
+// This work is free. You can redistribute it and/or modify it under the
+// terms of the Do What The Fuck You Want To Public License, Version 2,
+// as published by Sam Hocevar. See the LICENSE.md file for more details.
+
+/* Regression test: the BestScore ending criterion must count as stagnant the generations whose best score doesn't beat the record
+ * by the absolute or relative threshold, stop after exactly the given number of them, and start again from scratch for each run.
+ */
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "../src/sga.hpp"
+#include "check.hpp"
+
+INIT_RANDOM();
+
+//The best score of each generation is given by the test: flat, or growing by step (absolute) or by a factor of growth (relative)
+class Stagnant : public SGA::StaticGeneticAlgorithm<Stagnant, unsigned>
+{
+	public :
+
+		SGA::Score level, step, growth;
+
+		Stagnant(unsigned generations, SGA::Score absolute, SGA::Score relative) : level(0.0), step(0.0), growth(1.0)
+		{
+			setMainParameters(20, 0.1);
+			setChromosomesSize(5, 5);
+			setEndingCriterion(SGA::EndingCriterion::BestScore, 0.0, generations, absolute, relative);
+			setBudgets(0.0, 0.0, 0, 100);
+		}
+
+		unsigned randomGene() const
+		{
+			return SGA::Random::get(0u, 9u);
+		}
+
+		SGA::Score score(ChromosomeType const &) const
+		{
+			return level * std::pow(growth, _generation) + step * _generation;
+		}
+
+		//Check the ending criterion on a generation whose best score is the given one (a new run starts from scratch)
+		bool feed(SGA::Score best)
+		{
+			_scores.assign(1, best);
+			_ranking.assign(1, 0);
+			return EngineType::isEvolutionOver();
+		}
+
+		void restart()
+		{
+			prepare();
+		}
+};
+
+//Feed the scores one generation at a time and compare the answers of the ending criterion with the expected ones
+void feed(std::string const & name, Stagnant & algorithm, std::vector<SGA::Score> const & scores, std::vector<bool> const & over)
+{
+	algorithm.restart();
+	for (unsigned i=0 ; i<scores.size() ; i++)
+	{
+		if (algorithm.feed(scores[i]) != over[i])
+		{
+			expect(false, name + ": wrong answer at generation " + std::to_string(i+1) + " (best score " + std::to_string(scores[i]) + ")");
+			return;
+		}
+	}
+}
+
+int main()
+{
+	const SGA::Score nan = std::numeric_limits<SGA::Score>::quiet_NaN();
+
+	//Absolute threshold of 1: only the scores above the record + 1 restart the count (equal to it isn't enough)
+	Stagnant absolute(3, 1.0, 0.0);
+	feed("absolute threshold", absolute, {10.0, 10.5, 11.5, 12.0, 12.5, 12.4}, {false, false, false, false, false, true});
+	feed("absolute threshold", absolute, {10.0, 10.9, 11.0, 10.0}, {false, false, false, true});
+
+	//Relative threshold of 10% of the magnitude of the record, for positive and negative records
+	Stagnant relative(2, 0.0, 0.1);
+	feed("relative threshold", relative, {100.0, 109.0, 111.0, 122.0, 122.2, 134.0, 134.3}, {false, false, false, false, false, false, true});
+	feed("relative threshold of a negative record", relative, {-100.0, -95.0, -89.0, -80.0, -80.0, -80.0}, {false, false, false, false, false, true});
+
+	//Both thresholds: the larger one counts
+	Stagnant both(2, 5.0, 0.01);
+	feed("larger threshold", both, {100.0, 104.0, 106.0, 110.0, 110.9}, {false, false, false, false, true});
+	feed("larger threshold", both, {1000.0, 1009.0, 1011.0, 1020.0, 1021.0}, {false, false, false, false, true});
+
+	//A NaN is a record until a number replaces it, then a NaN is a stagnant generation
+	Stagnant nans(2, 0.0, 0.0);
+	feed("NaN record", nans, {nan, nan, -5.0, nan, -5.0}, {false, false, false, false, true});
+	feed("NaN record", nans, {nan, -5.0, -4.0, nan, nan}, {false, false, false, false, true});
+
+	//A flat run stops after its first generation (generation 0) and 5 stagnant ones
+	Stagnant flat(5, 0.0, 0.0);
+	flat.setSeed(1);
+	flat.run(true);
+	expect(flat.getNumberOfGenerations() == 5, "a flat run stopped at generation " + std::to_string(flat.getNumberOfGenerations()) + " instead of 5");
+
+	//A second run at a lower level doesn't inherit the record of the first one
+	flat.level = -10.0;
+	flat.run(true);
+	expect(flat.getNumberOfGenerations() == 5, "the second flat run stopped at generation " + std::to_string(flat.getNumberOfGenerations()) + " instead of 5");
+
+	//Improvements below the thresholds are stagnant generations, the ones above them keep the run going until its budget (generation 99)
+	//The small improvements add up against the record: 5 of them must stay below the threshold
+	Stagnant slow(5, 1.0, 0.0);
+	slow.step = 0.15;
+	slow.run(true);
+	expect(slow.getNumberOfGenerations() == 5, "improvements below the absolute threshold didn't stop the run (generation " + std::to_string(slow.getNumberOfGenerations()) + ")");
+
+	slow.step = 2.0;
+	slow.run(true);
+	expect(slow.getNumberOfGenerations() == 99, "improvements above the absolute threshold stopped the run (generation " + std::to_string(slow.getNumberOfGenerations()) + ")");
+
+	Stagnant growing(5, 0.0, 0.01);
+	growing.level = 1000.0;
+	growing.growth = 1.0015;
+	growing.run(true);
+	expect(growing.getNumberOfGenerations() == 5, "improvements below the relative threshold didn't stop the run (generation " + std::to_string(growing.getNumberOfGenerations()) + ")");
+
+	growing.growth = 1.02;
+	growing.run(true);
+	expect(growing.getNumberOfGenerations() == 99, "improvements above the relative threshold stopped the run (generation " + std::to_string(growing.getNumberOfGenerations()) + ")");
+
+	return report("stagnation");
+}